@@ -4,66 +4,24 @@
  * AUTOR: Sistema de Gerenciamento de Mochila
  * DATA: 2024
  * DESCRICAO: Sistema avancado de gerenciamento de inventario para sobrevivencia
- *            Implementa estruturas de dados, algoritmos de busca e ordenacao
+ *            Interface interativa (menu) sobre a biblioteca da mochila (mochila.h)
  * NIVEL: Mestre - Inclui busca binaria e ordenacao com multiplos criterios
  * =====================================================================================
  */
 
 #include <stdio.h>      // Funcoes de entrada/saida (printf, scanf, etc.)
-#include <string.h>     // Funcoes de manipulacao de strings (strcmp, strcspn, etc.)
+#include <string.h>     // Funcoes de manipulacao de strings (strcspn, etc.)
 #include <stdlib.h>     // Funcoes utilitarias (system, etc.)
 #include <stdbool.h>    // Tipo booleano (true/false)
 
+#include "mochila.h"    // Estruturas e operacoes da mochila (sem I/O)
+
 /*
  * =====================================================================================
  * CONSTANTES DO SISTEMA
  * =====================================================================================
  */
 #define MAX_ITENS 10    // Capacidade maxima da mochila
-#define MAX_NOME 50     // Tamanho maximo do nome do item
-#define MAX_TIPO 30     // Tamanho maximo do tipo do item
-
-/*
- * =====================================================================================
- * ESTRUTURAS DE DADOS
- * =====================================================================================
- */
-
-/**
- * Estrutura Item: Representa um componente coletado na ilha
- * @nome: Nome identificador do item (ex: "AK-47", "Kit Medico")
- * @tipo: Categoria do item (ex: "Arma", "Medicamento", "Equipamento")
- * @quantidade: Numero de unidades do item na mochila
- * @prioridade: Nivel de importancia (1=Muito Baixa, 2=Baixa, 3=Media, 4=Alta, 5=Muito Alta)
- */
-typedef struct {
-    char nome[MAX_NOME];        // Nome do item
-    char tipo[MAX_TIPO];        // Tipo/categoria do item
-    int quantidade;             // Quantidade disponivel
-    int prioridade;             // Prioridade de uso (1-5)
-} Item;
-
-/**
- * Enumeracao CriterioOrdenacao: Define os criterios disponiveis para ordenacao
- * NOME: Ordenacao alfabetica por nome (A-Z)
- * TIPO: Ordenacao alfabetica por tipo (A-Z)  
- * PRIORIDADE: Ordenacao por prioridade (Alta para Baixa)
- */
-typedef enum {
-    NOME = 1,           // Criterio: ordenar por nome
-    TIPO,               // Criterio: ordenar por tipo
-    PRIORIDADE          // Criterio: ordenar por prioridade
-} CriterioOrdenacao;
-
-/*
- * =====================================================================================
- * VARIAVEIS GLOBAIS DO SISTEMA
- * =====================================================================================
- */
-Item mochila[MAX_ITENS];        // Array principal que armazena os itens da mochila
-int numItens = 0;               // Contador atual de itens na mochila
-int comparacoes = 0;            // Contador de comparacoes para analise de performance
-bool ordenadaPorNome = false;   // Flag que indica se a mochila esta ordenada por nome
 
 /*
  * =====================================================================================
@@ -71,15 +29,22 @@ bool ordenadaPorNome = false;   // Flag que indica se a mochila esta ordenada po
  * =====================================================================================
  */
 void limparTela();                                          // Limpa a tela do console
-void exibirMenu();                                          // Exibe o menu principal do jogo
-void inserirItem();                                         // Adiciona um novo item na mochila
-void removerItem();                                         // Remove um item especifico da mochila
-void listarItens();                                         // Lista todos os itens com formatacao
-void buscarItemPorNome();                                   // Busca sequencial por nome
-void menuDeOrdenacao();                                     // Menu para escolher criterio de ordenacao
-void insertionSort(CriterioOrdenacao criterio);            // Algoritmo de ordenacao por insercao
-void buscaBinariaPorNome();                                 // Busca binaria otimizada por nome
-int compararItens(Item a, Item b, CriterioOrdenacao criterio); // Funcao auxiliar de comparacao
+void exibirMenu(const Mochila *m);                          // Exibe o menu principal do jogo
+void inserirItem(Mochila *m);                               // Adiciona um novo item na mochila
+void removerItem(Mochila *m);                               // Remove um item especifico da mochila
+void listarItens(const Mochila *m);                         // Lista todos os itens com formatacao
+void buscarItemPorNome(const Mochila *m);                   // Busca sequencial por nome
+void menuDeOrdenacao(Mochila *m);                           // Menu para escolher criterio de ordenacao
+void buscaBinariaPorNome(Mochila *m);                       // Busca binaria otimizada por nome
+void alterarQuantidade(Mochila *m);                         // Menu de incremento/decremento
+void alternarModoMesclagem(Mochila *m);                     // Liga/desliga mesclagem na insercao
+void buscaAutomatica(Mochila *m);                           // Busca com estrategia adaptativa
+void desfazerOperacao(Mochila *m);                          // Volta para a versao anterior
+void refazerOperacao(Mochila *m);                           // Reaplica a versao desfeita
+void salvarSnapshot(Mochila *m);                            // Guarda a versao atual com um nome
+void restaurarSnapshot(Mochila *m);                         // Volta para um snapshot salvo
+void lerNome(char *destino, int tamanho);                   // Le uma linha do teclado sem '\n'
+void exibirDetalhesItem(const Item *item, int indice);      // Exibe os campos de um item
 
 /*
  * =====================================================================================
@@ -89,18 +54,28 @@ int compararItens(Item a, Item b, CriterioOrdenacao criterio); // Funcao auxilia
 
 /**
  * Funcao main: Controla o fluxo principal do programa
- * 
+ *
  * FUNCIONAMENTO:
- * 1. Exibe mensagem de boas-vindas
- * 2. Loop principal que exibe menu e processa opcoes
- * 3. Switch-case para direcionar para funcoes especificas
- * 4. Controle de pausa entre operacoes
- * 5. Encerramento gracioso do programa
- * 
+ * 1. Inicializa o contexto da mochila (biblioteca)
+ * 2. Exibe mensagem de boas-vindas
+ * 3. Loop principal que exibe menu e processa opcoes
+ * 4. Switch-case para direcionar para funcoes especificas
+ * 5. Controle de pausa entre operacoes
+ * 6. Encerramento gracioso do programa
+ *
  * @return: 0 se execucao bem-sucedida
  */
 int main() {
-    int opcao;  // Variavel para armazenar a opcao escolhida pelo usuario
+    int opcao;          // Variavel para armazenar a opcao escolhida pelo usuario
+    Mochila mochila;    // Contexto com todo o estado da mochila
+    
+    if(mochilaInicializar(&mochila, MAX_ITENS) != MOCHILA_OK) {
+        printf("Erro: memoria insuficiente para criar a mochila.\n");
+        return 1;
+    }
+    if(mochilaHabilitarHistorico(&mochila) != MOCHILA_OK) {
+        printf("Aviso: memoria insuficiente; desfazer/refazer indisponivel.\n");
+    }
     
     // Mensagem de boas-vindas ao jogador
     printf("BEM-VINDO AO DESAFIO CODIGO DA ILHA - EDICAO FREE FIRE!\n");
@@ -108,29 +83,50 @@ int main() {
     
     // Loop principal do programa - continua ate o usuario escolher sair (opcao 0)
     do {
-        exibirMenu();                           // Exibe o menu de opcoes
+        exibirMenu(&mochila);                   // Exibe o menu de opcoes
         printf("Escolha uma opcao: ");
         scanf("%d", &opcao);                    // Le a opcao do usuario
         
         // Processa a opcao escolhida
         switch(opcao) {
             case 1:
-                inserirItem();                  // Adicionar item a mochila
+                inserirItem(&mochila);          // Adicionar item a mochila
                 break;
             case 2:
-                removerItem();                  // Remover item da mochila
+                removerItem(&mochila);          // Remover item da mochila
                 break;
             case 3:
-                listarItens();                  // Listar todos os itens
+                listarItens(&mochila);          // Listar todos os itens
                 break;
             case 4:
-                buscarItemPorNome();            // Busca sequencial
+                buscarItemPorNome(&mochila);    // Busca sequencial
                 break;
             case 5:
-                menuDeOrdenacao();              // Menu de ordenacao
+                menuDeOrdenacao(&mochila);      // Menu de ordenacao
                 break;
             case 6:
-                buscaBinariaPorNome();          // Busca binaria
+                buscaBinariaPorNome(&mochila);  // Busca binaria
+                break;
+            case 7:
+                alterarQuantidade(&mochila);    // Incrementar/decrementar quantidade
+                break;
+            case 8:
+                alternarModoMesclagem(&mochila); // Modo de insercao de duplicados
+                break;
+            case 9:
+                buscaAutomatica(&mochila);      // Busca adaptativa
+                break;
+            case 10:
+                desfazerOperacao(&mochila);     // Desfazer ultima operacao
+                break;
+            case 11:
+                refazerOperacao(&mochila);      // Refazer operacao desfeita
+                break;
+            case 12:
+                salvarSnapshot(&mochila);       // Salvar snapshot nomeado
+                break;
+            case 13:
+                restaurarSnapshot(&mochila);    // Restaurar snapshot nomeado
                 break;
             case 0:
                 printf("\nObrigado por jogar! Boa sorte na ilha!\n");
@@ -145,9 +141,10 @@ int main() {
             getchar();  // Limpa o buffer
             getchar();  // Aguarda Enter
         }
-        
+    
     } while(opcao != 0);  // Continua ate escolher sair
     
+    mochilaLiberar(&mochila);   // Devolve a memoria do contexto
     return 0;  // Indica execucao bem-sucedida
 }
 
@@ -172,14 +169,15 @@ void limparTela() {
  * - Mostra status da mochila (quantidade de itens, se está ordenada)
  * - Lista todas as opções do menu numeradas
  */
-void exibirMenu() {
+void exibirMenu(const Mochila *m) {
     limparTela();
     
     // Cabeçalho do menu com informações da mochila
     printf("MOCHILA DE SOBREVIVENCIA - FREE FIRE\n");
     printf("===============================================\n");
-    printf("Itens na mochila: %d/%d\n", numItens, MAX_ITENS);
-    printf("Ordenada por nome: %s\n", ordenadaPorNome ? "SIM" : "NAO");
+    printf("Itens na mochila: %d/%d\n", m->numItens, m->capacidade);
+    printf("Ordenada por nome: %s\n", m->ordenadaPorNome ? "SIM" : "NAO");
+    printf("Mesclar nomes repetidos: %s\n", m->mesclarDuplicados ? "SIM" : "NAO");
     printf("===============================================\n\n");
     
     // Opções do menu principal
@@ -190,97 +188,66 @@ void exibirMenu() {
     printf("4  Buscar item por nome (busca sequencial)\n");
     printf("5  Ordenar itens por criterio\n");
     printf("6  Buscar item por nome (busca binaria)\n");
+    printf("7  Alterar quantidade de um item (+/-)\n");
+    printf("8  Alternar modo de mesclagem na insercao\n");
+    printf("9  Buscar item por nome (busca automatica)\n");
+    printf("10 Desfazer ultima operacao\n");
+    printf("11 Refazer operacao desfeita\n");
+    printf("12 Salvar snapshot da mochila\n");
+    printf("13 Restaurar snapshot da mochila\n");
     printf("0  Sair do jogo\n");
     printf("===============================================\n");
 }
 
 /**
- * Função para comparar dois itens baseado no critério de ordenação
- * @param a Primeiro item a ser comparado
- * @param b Segundo item a ser comparado
- * @param criterio Critério de comparação (NOME, TIPO ou PRIORIDADE)
- * @return Valor negativo se a < b, positivo se a > b, zero se iguais
- * 
- * Incrementa o contador global de comparações para análise de performance
+ * Função auxiliar de entrada: lê uma linha e remove a quebra de linha
+ * Descarta antes o '\n' residual deixado pelo scanf anterior.
+ * @param destino Buffer que recebe o texto
+ * @param tamanho Tamanho do buffer
  */
-int compararItens(Item a, Item b, CriterioOrdenacao criterio) {
-    comparacoes++; // Incrementa contador de comparações para estatísticas
-    
-    switch(criterio) {
-        case NOME:
-            // Comparação lexicográfica dos nomes (A-Z)
-            return strcmp(a.nome, b.nome);
-        case TIPO:
-            // Comparação lexicográfica dos tipos (A-Z)
-            return strcmp(a.tipo, b.tipo);
-        case PRIORIDADE:
-            // Ordenação decrescente (prioridade mais alta primeiro)
-            // Subtração invertida para ordem decrescente
-            return b.prioridade - a.prioridade;
-        default:
-            return 0;   // Caso padrão: itens considerados iguais
-    }
+void lerNome(char *destino, int tamanho) {
+    getchar(); // Limpar buffer do scanf anterior
+    fgets(destino, tamanho, stdin);
+    destino[strcspn(destino, "\n")] = 0; // Remove quebra de linha
 }
 
-// Função de ordenação por inserção (Insertion Sort)
 /**
- * Algoritmo de Ordenação por Inserção (Insertion Sort)
- * 
- * FUNCIONAMENTO:
- * 1. Percorre o array da segunda posição até o final
- * 2. Para cada elemento, compara com os anteriores
- * 3. Move os elementos maiores uma posição à direita
- * 4. Insere o elemento na posição correta
- * 
- * COMPLEXIDADE:
- * - Melhor caso: O(n) - array já ordenado
- * - Pior caso: O(n²) - array ordenado inversamente
- * - Caso médio: O(n²)
- * 
- * @param criterio Critério de ordenação (NOME, TIPO ou PRIORIDADE)
+ * Função auxiliar de saída: exibe todos os campos de um item encontrado
+ * @param item Item a ser exibido
+ * @param indice Posição (0-based) do item na mochila
  */
-void insertionSort(CriterioOrdenacao criterio) {
-    comparacoes = 0; // Resetar contador para estatísticas
-    
-    // Percorre o array começando do segundo elemento (índice 1)
-    for(int i = 1; i < numItens; i++) {
-        Item chave = mochila[i];    // Elemento a ser inserido na posição correta
-        int j = i - 1;              // Índice do último elemento da parte ordenada
-        
-        // Move elementos maiores que a chave uma posição à direita
-        // Continua até encontrar a posição correta ou chegar ao início
-        while(j >= 0 && compararItens(mochila[j], chave, criterio) > 0) {
-            mochila[j + 1] = mochila[j];    // Move elemento para a direita
-            j--;                            // Verifica próximo elemento à esquerda
-        }
-        
-        // Insere a chave na posição correta encontrada
-        mochila[j + 1] = chave;
-    }
-    
-    // Atualizar flag de ordenação por nome para otimizar busca binária
-    if(criterio == NOME) {
-        ordenadaPorNome = true;     // Habilita busca binária
-    } else {
-        ordenadaPorNome = false;    // Desabilita busca binária
+void exibirDetalhesItem(const Item *item, int indice) {
+    printf("Posicao na mochila: %d\n", indice + 1);
+    printf("Nome: %s\n", item->nome);
+    printf("Tipo: %s\n", item->tipo);
+    printf("Quantidade: %d\n", item->quantidade);
+    printf("Prioridade: %d", item->prioridade);
+    
+    // Tradução da prioridade numérica para texto
+    switch(item->prioridade) {
+        case 1: printf(" (Muito Baixa)\n"); break;
+        case 2: printf(" (Baixa)\n"); break;
+        case 3: printf(" (Media)\n"); break;
+        case 4: printf(" (Alta)\n"); break;
+        case 5: printf(" (Muito Alta)\n"); break;
     }
 }
 
 /**
  * Menu de Ordenação - Interface para escolha do critério de ordenação
- * 
+ *
  * FUNCIONALIDADES:
  * - Verifica se há itens para ordenar
  * - Apresenta opções de critérios de ordenação
- * - Executa a ordenação escolhida
+ * - Executa a ordenação escolhida (mochilaOrdenar)
  * - Exibe estatísticas de performance (número de comparações)
- * - Atualiza flags de controle do sistema
  */
-void menuDeOrdenacao() {
+void menuDeOrdenacao(Mochila *m) {
     int opcao;
+    int comparacoes = 0;    // Preenchido por mochilaOrdenar
     
     // Validação: verifica se há itens para ordenar
-    if(numItens == 0) {
+    if(m->numItens == 0) {
         printf("\nMOCHILA VAZIA! Nao ha itens para ordenar.\n");
         return;
     }
@@ -300,23 +267,20 @@ void menuDeOrdenacao() {
     // Processamento da opção escolhida
     switch(opcao) {
         case 1:
-            // Ordenação alfabética por nome (A-Z)
-            insertionSort(NOME);
-            ordenadaPorNome = true;     // Habilita busca binária
+            // Ordenação alfabética por nome (A-Z) - habilita busca binária
+            mochilaOrdenar(m, NOME, &comparacoes);
             printf("Itens ordenados por nome (A-Z)!\n");
             printf("Comparacoes realizadas: %d\n", comparacoes);
             break;
         case 2:
             // Ordenação alfabética por tipo (A-Z)
-            insertionSort(TIPO);
-            ordenadaPorNome = false;    // Desabilita busca binária
+            mochilaOrdenar(m, TIPO, &comparacoes);
             printf("Itens ordenados por tipo (A-Z)!\n");
             printf("Comparacoes realizadas: %d\n", comparacoes);
             break;
         case 3:
             // Ordenação por prioridade (decrescente: 5->1)
-            insertionSort(PRIORIDADE);
-            ordenadaPorNome = false;    // Desabilita busca binária
+            mochilaOrdenar(m, PRIORIDADE, &comparacoes);
             printf("Itens ordenados por prioridade (Alta -> Baixa)!\n");
             printf("Comparacoes realizadas: %d\n", comparacoes);
             break;
@@ -324,7 +288,6 @@ void menuDeOrdenacao() {
             // Retorna ao menu principal
             printf("\nVoltando ao menu principal...\n");
             return;
-            break;
         default:
             // Tratamento de erro para opção inválida
             printf("\nOpcao invalida!\n");
@@ -335,34 +298,25 @@ void menuDeOrdenacao() {
     printf("\nDica: Use a opcao 3 do menu principal para ver os itens ordenados.\n");
 }
 
-// Função de busca binária por nome
 /**
- * Algoritmo de Busca Binária por Nome
- * 
+ * Interface da Busca Binária por Nome
+ *
  * FUNCIONAMENTO:
- * 1. Verifica se os dados estão ordenados por nome (pré-requisito)
- * 2. Divide o array pela metade a cada iteração
- * 3. Compara o elemento do meio com o valor procurado
- * 4. Elimina metade dos elementos a cada comparação
- * 5. Continua até encontrar o elemento ou esgotar possibilidades
- * 
- * COMPLEXIDADE:
- * - Melhor caso: O(1) - elemento está no meio
- * - Pior caso: O(log n) - elemento não existe ou está nas extremidades
- * - Caso médio: O(log n)
- * 
- * PRÉ-REQUISITO: Array deve estar ordenado por nome
- * VANTAGEM: Muito eficiente para grandes volumes de dados
+ * 1. Verifica o pré-requisito (ordenação por nome) e oferece ordenar
+ * 2. Lê o nome procurado
+ * 3. Executa mochilaBuscarBinaria e exibe o resultado e o número de passos
+ *
+ * COMPLEXIDADE: O(log n)
  */
-void buscaBinariaPorNome() {
+void buscaBinariaPorNome(Mochila *m) {
     // Validação: verifica se há itens para buscar
-    if(numItens == 0) {
+    if(m->numItens == 0) {
         printf("\nMOCHILA VAZIA! Nao ha itens para buscar.\n");
         return;
     }
     
     // Verificação do pré-requisito: dados ordenados por nome
-    if(!ordenadaPorNome) {
+    if(!m->ordenadaPorNome) {
         printf("\nATENCAO: BUSCA BINARIA REQUER ORDENACAO!\n");
         printf("===========================================\n");
         printf("A busca binaria so funciona com dados ordenados por nome.\n");
@@ -375,7 +329,7 @@ void buscaBinariaPorNome() {
         // Opção de ordenação automática para facilitar o uso
         if(resposta == 's' || resposta == 'S') {
             printf("\nOrdenando por nome...\n");
-            insertionSort(NOME);
+            mochilaOrdenar(m, NOME, NULL);
             printf("Itens ordenados! Prosseguindo com a busca binaria...\n");
         } else {
             printf("\nBusca cancelada. Ordene os itens primeiro.\n");
@@ -384,70 +338,26 @@ void buscaBinariaPorNome() {
     }
     
     char nomeBuscar[MAX_NOME];
+    int indice;             // Posição do item encontrado
+    int passos = 0;         // Contador para análise de performance
     
     // Interface de entrada para o usuário
     printf("\nBUSCA BINARIA POR NOME\n");
     printf("=========================\n");
     printf("Digite o nome do item que deseja buscar: ");
-    getchar(); // Limpar buffer do scanf anterior
-    fgets(nomeBuscar, MAX_NOME, stdin);
-    nomeBuscar[strcspn(nomeBuscar, "\n")] = 0; // Remove quebra de linha
+    lerNome(nomeBuscar, MAX_NOME);
     
     printf("\nRealizando busca binaria...\n");
     
-    // ALGORITMO DE BUSCA BINÁRIA
-    int esquerda = 0;           // Índice inicial (limite esquerdo)
-    int direita = numItens - 1; // Índice final (limite direito)
-    int meio;                   // Índice do elemento central
-    bool encontrado = false;    // Flag de controle
-    int passos = 0;             // Contador para análise de performance
-    
-    // Loop principal: continua enquanto há elementos para verificar
-    while(esquerda <= direita) {
-        passos++;
-        meio = (esquerda + direita) / 2;    // Calcula posição central
-        int comparacao = strcmp(mochila[meio].nome, nomeBuscar);
-        
-        // Feedback visual do processo de busca
-        printf("   Passo %d: Verificando posicao %d ('%s')\n", 
-               passos, meio + 1, mochila[meio].nome);
-        
-        if(comparacao == 0) {
-            // ENCONTRADO: nome do meio é igual ao procurado
-            encontrado = true;
-            break;
-        } else if(comparacao < 0) {
-            // Elemento procurado está na metade direita
-            esquerda = meio + 1;
-        } else {
-            // Elemento procurado está na metade esquerda
-            direita = meio - 1;
-        }
-    }
-    
-    // Processamento do resultado da busca
-    if(encontrado) {
+    if(mochilaBuscarBinaria(m, nomeBuscar, &indice, &passos) == MOCHILA_OK) {
         // SUCESSO: item encontrado
         printf("\nITEM ENCONTRADO EM %d PASSOS!\n", passos);
         printf("================================\n");
-        printf("Posicao na mochila: %d\n", meio + 1);
-        printf("Nome: %s\n", mochila[meio].nome);
-        printf("Tipo: %s\n", mochila[meio].tipo);
-        printf("Quantidade: %d\n", mochila[meio].quantidade);
-        printf("Prioridade: %d", mochila[meio].prioridade);
-        
-        // Tradução da prioridade numérica para texto
-        switch(mochila[meio].prioridade) {
-            case 1: printf(" (Muito Baixa)\n"); break;
-            case 2: printf(" (Baixa)\n"); break;
-            case 3: printf(" (Media)\n"); break;
-            case 4: printf(" (Alta)\n"); break;
-            case 5: printf(" (Muito Alta)\n"); break;
-        }
+        exibirDetalhesItem(&m->itens[indice], indice);
         
         // Análise de eficiência comparativa
         printf("\nEficiencia: Busca binaria completada em apenas %d passos!\n", passos);
-        printf("Comparacao: Uma busca sequencial levaria ate %d passos.\n", numItens);
+        printf("Comparacao: Uma busca sequencial levaria ate %d passos.\n", m->numItens);
     } else {
         // FALHA: item não encontrado
         printf("\nITEM NAO ENCONTRADO!\n");
@@ -462,73 +372,38 @@ void buscaBinariaPorNome() {
 }
 
 /**
- * Algoritmo de Busca Sequencial por Nome
- * 
+ * Interface da Busca Sequencial por Nome
+ *
  * FUNCIONAMENTO:
- * 1. Percorre o array do início ao fim
- * 2. Compara cada elemento com o valor procurado
- * 3. Para na primeira ocorrência encontrada
- * 4. Se chegar ao final sem encontrar, retorna "não encontrado"
- * 
- * COMPLEXIDADE:
- * - Melhor caso: O(1) - elemento está na primeira posição
- * - Pior caso: O(n) - elemento está na última posição ou não existe
- * - Caso médio: O(n/2)
- * 
- * VANTAGEM: Funciona com dados não ordenados
- * DESVANTAGEM: Ineficiente para grandes volumes de dados
+ * 1. Lê o nome procurado
+ * 2. Executa mochilaBuscarSequencial (primeira ocorrência)
+ * 3. Exibe os detalhes ou dicas se não encontrado
+ *
+ * COMPLEXIDADE: O(n) - funciona com dados não ordenados
  */
-void buscarItemPorNome() {
+void buscarItemPorNome(const Mochila *m) {
     // Validação: verifica se há itens para buscar
-    if(numItens == 0) {
+    if(m->numItens == 0) {
         printf("\nMOCHILA VAZIA! Nao ha itens para buscar.\n");
         return;
     }
     
     char nomeBuscar[MAX_NOME];
-    bool encontrado = false;    // Flag de controle
-    int indice = -1;           // Índice do item encontrado
+    int indice;             // Posição do item encontrado
     
     // Interface de entrada para o usuário
     printf("\nBUSCA SEQUENCIAL POR NOME\n");
     printf("============================\n");
     printf("Digite o nome do item que deseja buscar: ");
-    getchar(); // Limpar buffer do scanf anterior
-    fgets(nomeBuscar, MAX_NOME, stdin);
-    nomeBuscar[strcspn(nomeBuscar, "\n")] = 0; // Remove quebra de linha
+    lerNome(nomeBuscar, MAX_NOME);
     
     printf("\nRealizando busca sequencial...\n");
     
-    // ALGORITMO DE BUSCA SEQUENCIAL
-    // Percorre todos os elementos do array sequencialmente
-    for(int i = 0; i < numItens; i++) {
-        // Compara o nome atual com o nome procurado
-        if(strcmp(mochila[i].nome, nomeBuscar) == 0) {
-            encontrado = true;  // Marca como encontrado
-            indice = i;         // Armazena a posição
-            break;              // Para a busca (primeira ocorrência)
-        }
-    }
-    
-    // Processamento do resultado da busca
-    if(encontrado) {
+    if(mochilaBuscarSequencial(m, nomeBuscar, &indice, NULL) == MOCHILA_OK) {
         // SUCESSO: item encontrado
         printf("\nITEM ENCONTRADO!\n");
         printf("===================\n");
-        printf("Posicao na mochila: %d\n", indice + 1);
-        printf("Nome: %s\n", mochila[indice].nome);
-        printf("Tipo: %s\n", mochila[indice].tipo);
-        printf("Quantidade: %d\n", mochila[indice].quantidade);
-        printf("Prioridade: %d", mochila[indice].prioridade);
-        
-        // Tradução da prioridade numérica para texto
-        switch(mochila[indice].prioridade) {
-            case 1: printf(" (Muito Baixa)\n"); break;
-            case 2: printf(" (Baixa)\n"); break;
-            case 3: printf(" (Media)\n"); break;
-            case 4: printf(" (Alta)\n"); break;
-            case 5: printf(" (Muito Alta)\n"); break;
-        }
+        exibirDetalhesItem(&m->itens[indice], indice);
         
         printf("\nStatus: Item essencial para sobrevivencia na ilha!\n");
     } else {
@@ -543,53 +418,72 @@ void buscarItemPorNome() {
     }
 }
 
-// Função para inserir um novo item na mochila
 /**
- * Função para inserir um novo item na mochila
- * 
+ * Interface para inserir um novo item na mochila
+ *
  * VALIDAÇÕES IMPLEMENTADAS:
  * - Verifica se há espaço disponível na mochila (capacidade máxima)
- * - Valida entrada de prioridade (deve estar entre 1-5)
- * - Limpa buffers de entrada para evitar problemas de leitura
- * - Remove caracteres de quebra de linha das strings
- * 
- * TRATAMENTO DE ERROS:
- * - Retorna imediatamente se mochila estiver cheia
- * - Loop de validação para prioridade inválida
- * - Mensagens informativas para orientar o usuário
- * 
- * EFEITOS COLATERAIS:
- * - Incrementa contador global de itens (numItens)
- * - Desabilita flag de ordenação por nome (ordenadaPorNome = false)
- * - Modifica array global da mochila
+ * - Valida entrada de quantidade (>= 0) e prioridade (1-5)
+ * - Com mesclagem ativa, um nome já existente pede apenas a quantidade a somar
+ *
+ * As regras de inserção (capacidade, mesclagem, agregados) ficam em mochilaInserir.
  */
-void inserirItem() {
-    // VALIDAÇÃO CRÍTICA: Verificar capacidade da mochila
-    if(numItens >= MAX_ITENS) {
+void inserirItem(Mochila *m) {
+    // Com mesclagem ativa, um nome repetido ainda cabe mesmo com a mochila cheia
+    if(m->numItens >= m->capacidade && !m->mesclarDuplicados) {
         printf("\nMOCHILA CHEIA! Nao e possivel adicionar mais itens.\n");
         printf("Dica: Remova alguns itens antes de adicionar novos.\n");
         return;  // Saída antecipada para evitar overflow
     }
     
     Item novoItem;  // Estrutura temporária para o novo item
+    int indice;     // Posição final do item (novo ou mesclado)
     
     // Interface de entrada de dados
     printf("\nADICIONANDO NOVO ITEM A MOCHILA\n");
     printf("==================================\n");
     
-    // ENTRADA DE DADOS COM TRATAMENTO DE BUFFER
     printf("Nome do item: ");
-    getchar(); // CRÍTICO: Limpar buffer residual do scanf anterior
-    fgets(novoItem.nome, MAX_NOME, stdin);
-    novoItem.nome[strcspn(novoItem.nome, "\n")] = 0; // Remove quebra de linha
+    lerNome(novoItem.nome, MAX_NOME);
+    
+    // MESCLAGEM: nome já existente apenas recebe a nova quantidade
+    if(m->mesclarDuplicados && mochilaLocalizar(m, novoItem.nome, &indice) == MOCHILA_OK) {
+        printf("Item ja existe na mochila (quantidade atual: %d).\n",
+               m->itens[indice].quantidade);
+        printf("Quantidade a somar: ");
+        scanf("%d", &novoItem.quantidade);
+        novoItem.prioridade = m->itens[indice].prioridade;  // Mesclagem mantém a prioridade
+        
+        if(mochilaInserir(m, &novoItem, &indice, NULL) != MOCHILA_OK) {
+            printf("\nQuantidade invalida! Informe um valor nao negativo dentro do limite.\n");
+            return;
+        }
+        
+        printf("\nItem '%s' mesclado! Nova quantidade: %d\n",
+               m->itens[indice].nome, m->itens[indice].quantidade);
+        return;
+    }
+    
+    // Nome novo: agora sim a capacidade precisa ser respeitada
+    if(m->numItens >= m->capacidade) {
+        printf("\nMOCHILA CHEIA! Nao e possivel adicionar mais itens.\n");
+        printf("Dica: Remova alguns itens antes de adicionar novos.\n");
+        return;
+    }
     
     printf("Tipo do item: ");
     fgets(novoItem.tipo, MAX_TIPO, stdin);
     novoItem.tipo[strcspn(novoItem.tipo, "\n")] = 0; // Remove quebra de linha
     
-    // ENTRADA NUMÉRICA: Quantidade (sem validação específica - aceita qualquer inteiro)
-    printf("Quantidade: ");
-    scanf("%d", &novoItem.quantidade);
+    // ENTRADA NUMÉRICA: Quantidade não pode ser negativa
+    do {
+        printf("Quantidade: ");
+        scanf("%d", &novoItem.quantidade);
+        
+        if(novoItem.quantidade < 0) {
+            printf("Quantidade invalida! Digite um valor maior ou igual a 0.\n");
+        }
+    } while(novoItem.quantidade < 0);
     
     // VALIDAÇÃO RIGOROSA: Prioridade deve estar no intervalo [1,5]
     do {
@@ -602,89 +496,53 @@ void inserirItem() {
         }
     } while(novoItem.prioridade < 1 || novoItem.prioridade > 5);
     
-    // INSERÇÃO SEGURA: Adicionar item na próxima posição disponível
-    mochila[numItens] = novoItem;   // Copia estrutura completa
-    numItens++;                     // Incrementa contador
-    
-    // ATUALIZAÇÃO DE ESTADO: Mochila não está mais ordenada por nome
-    ordenadaPorNome = false;        // Desabilita busca binária
+    if(mochilaInserir(m, &novoItem, &indice, NULL) != MOCHILA_OK) {
+        printf("\nNao foi possivel adicionar o item.\n");
+        return;
+    }
     
     // FEEDBACK DE SUCESSO
     printf("\nItem '%s' adicionado com sucesso!\n", novoItem.nome);
-    printf("Total de itens na mochila: %d/%d\n", numItens, MAX_ITENS);
+    printf("Total de itens na mochila: %d/%d\n", m->numItens, m->capacidade);
 }
 
 /**
- * Função para remover um item específico da mochila
- * 
- * VALIDAÇÕES IMPLEMENTADAS:
- * - Verifica se há itens para remover (mochila não vazia)
- * - Busca sequencial para localizar o item
- * - Confirmação visual antes da remoção
- * 
+ * Interface para remover um item específico da mochila
+ *
  * TRATAMENTO DE ERROS:
  * - Retorna imediatamente se mochila estiver vazia
  * - Informa se item não foi encontrado
  * - Fornece dicas para correção de problemas
- * 
- * ALGORITMO DE REMOÇÃO:
- * - Busca linear para encontrar o item
- * - Reorganização do array (shift left) para manter contiguidade
- * - Atualização do contador de itens
+ *
+ * A localização e o deslocamento do vetor ficam em mochilaRemover.
  */
-void removerItem() {
+void removerItem(Mochila *m) {
     // VALIDAÇÃO INICIAL: Verificar se há itens para remover
-    if(numItens == 0) {
+    if(m->numItens == 0) {
         printf("\nMOCHILA VAZIA! Nao ha itens para remover.\n");
         return;  // Saída antecipada - operação impossível
     }
     
     char nomeRemover[MAX_NOME];     // Buffer para nome do item a remover
-    bool encontrado = false;        // Flag de controle da busca
-    int indice = -1;               // Índice do item encontrado (-1 = não encontrado)
+    Item removido;                  // Cópia do item removido para confirmação
     
     // Interface de entrada
     printf("\nREMOVENDO ITEM DA MOCHILA\n");
     printf("=============================\n");
     printf("Digite o nome do item a ser removido: ");
+    lerNome(nomeRemover, MAX_NOME);
     
-    // ENTRADA DE DADOS COM LIMPEZA DE BUFFER
-    getchar(); // Limpar buffer residual
-    fgets(nomeRemover, MAX_NOME, stdin);
-    nomeRemover[strcspn(nomeRemover, "\n")] = 0; // Remove quebra de linha
-    
-    // ALGORITMO DE BUSCA SEQUENCIAL
-    // Percorre todo o array procurando pelo nome exato
-    for(int i = 0; i < numItens; i++) {
-        if(strcmp(mochila[i].nome, nomeRemover) == 0) {
-            encontrado = true;      // Marca como encontrado
-            indice = i;            // Armazena posição
-            break;                 // Para a busca (primeira ocorrência)
-        }
-    }
-    
-    // PROCESSAMENTO DO RESULTADO DA BUSCA
-    if(encontrado) {
-        // CONFIRMAÇÃO VISUAL: Mostra dados do item antes de remover
+    if(mochilaRemover(m, nomeRemover, &removido) == MOCHILA_OK) {
+        // CONFIRMAÇÃO VISUAL: Mostra dados do item removido
         printf("\nItem encontrado:\n");
-        printf("   Nome: %s\n", mochila[indice].nome);
-        printf("   Tipo: %s\n", mochila[indice].tipo);
-        printf("   Quantidade: %d\n", mochila[indice].quantidade);
-        printf("   Prioridade: %d\n", mochila[indice].prioridade);
-        
-        // ALGORITMO DE REORGANIZAÇÃO (SHIFT LEFT)
-        // Move todos os elementos após o removido uma posição à esquerda
-        // Isso mantém a contiguidade do array sem "buracos"
-        for(int i = indice; i < numItens - 1; i++) {
-            mochila[i] = mochila[i + 1];    // Copia elemento seguinte
-        }
-        
-        // ATUALIZAÇÃO DE ESTADO
-        numItens--;     // Decrementa contador de itens
+        printf("   Nome: %s\n", removido.nome);
+        printf("   Tipo: %s\n", removido.tipo);
+        printf("   Quantidade: %d\n", removido.quantidade);
+        printf("   Prioridade: %d\n", removido.prioridade);
         
         // FEEDBACK DE SUCESSO
         printf("\nItem '%s' removido com sucesso!\n", nomeRemover);
-        printf("Total de itens na mochila: %d/%d\n", numItens, MAX_ITENS);
+        printf("Total de itens na mochila: %d/%d\n", m->numItens, m->capacidade);
     } else {
         // TRATAMENTO DE ERRO: Item não encontrado
         printf("\nItem '%s' nao encontrado na mochila.\n", nomeRemover);
@@ -694,23 +552,19 @@ void removerItem() {
 
 /**
  * Função para listar todos os itens da mochila com formatação tabular
- * 
- * VALIDAÇÕES IMPLEMENTADAS:
- * - Verifica se há itens para exibir
- * - Calcula estatísticas em tempo real
- * 
+ *
  * FUNCIONALIDADES:
  * - Exibição tabular formatada com bordas
- * - Cálculo automático de estatísticas
+ * - Exibição dos agregados mantidos pela biblioteca
  * - Informações de capacidade e utilização
- * 
+ *
  * TRATAMENTO DE CASOS ESPECIAIS:
  * - Mochila vazia: mensagem informativa
  * - Formatação consistente independente do conteúdo
  */
-void listarItens() {
+void listarItens(const Mochila *m) {
     // VALIDAÇÃO: Verificar se há itens para exibir
-    if(numItens == 0) {
+    if(m->numItens == 0) {
         printf("\nMOCHILA VAZIA!\n");
         printf("Adicione alguns itens para comecar sua aventura na ilha.\n");
         return;  // Saída antecipada - nada para mostrar
@@ -719,7 +573,7 @@ void listarItens() {
     // CABEÇALHO DA LISTAGEM
     printf("\nINVENTARIO DA MOCHILA\n");
     printf("========================\n");
-    printf("Total de itens: %d/%d\n\n", numItens, MAX_ITENS);
+    printf("Total de itens: %d/%d\n\n", m->numItens, m->capacidade);
     
     // TABELA FORMATADA COM BORDAS UNICODE
     // Utiliza caracteres especiais para criar uma tabela visualmente atrativa
@@ -728,36 +582,204 @@ void listarItens() {
     printf("├─────┼─────────────────────┼─────────────────┼──────────┼───────────┤\n");
     
     // LOOP DE EXIBIÇÃO: Percorre todos os itens
-    for(int i = 0; i < numItens; i++) {
+    for(int i = 0; i < m->numItens; i++) {
         // Formatação com largura fixa para alinhamento
-        printf("│ %-3d │ %-19s │ %-15s │ %-8d │ %-9d │\n", 
-               i + 1,                   // Número sequencial (1-based)
-               mochila[i].nome,         // Nome do item
-               mochila[i].tipo,         // Tipo/categoria
-               mochila[i].quantidade,   // Quantidade
-               mochila[i].prioridade);  // Prioridade
+        printf("│ %-3d │ %-19s │ %-15s │ %-8d │ %-9d │\n",
+               i + 1,                       // Número sequencial (1-based)
+               m->itens[i].nome,            // Nome do item
+               m->itens[i].tipo,            // Tipo/categoria
+               m->itens[i].quantidade,      // Quantidade
+               m->itens[i].prioridade);     // Prioridade
     }
     
     // FECHAMENTO DA TABELA
     printf("└─────┴─────────────────────┴─────────────────┴──────────┴───────────┘\n");
     
-    // CÁLCULO DE ESTATÍSTICAS EM TEMPO REAL
-    int totalQuantidade = 0;    // Soma de todas as quantidades
-    int prioridadeAlta = 0;     // Contador de itens de alta prioridade
+    // EXIBIÇÃO DE ESTATÍSTICAS
+    // Os agregados são mantidos por inserção/remoção/ajuste, sem recalcular aqui
+    printf("\nESTATISTICAS:\n");
+    printf("   • Total de unidades: %d\n", m->totalUnidades);
+    printf("   • Itens de alta prioridade (4-5): %d\n", m->itensAltaPrioridade);
+    printf("   • Espaco disponivel: %d slots\n", m->capacidade - m->numItens);
+}
+
+/**
+ * Menu para incrementar ou decrementar a quantidade de um item
+ *
+ * FUNCIONAMENTO:
+ * 1. Localiza o item pelo nome com o despachante adaptativo (mochilaLocalizar)
+ * 2. Lê a variação desejada (ex: 5 para adicionar, -2 para consumir)
+ * 3. Aplica a variação no próprio item, sem remover e reinserir
+ *
+ * VANTAGEM: Evita o deslocamento O(n) da remoção e mantém a ordenação
+ */
+void alterarQuantidade(Mochila *m) {
+    if(m->numItens == 0) {
+        printf("\nMOCHILA VAZIA! Nao ha itens para alterar.\n");
+        return;
+    }
     
-    // Loop para calcular estatísticas
-    for(int i = 0; i < numItens; i++) {
-        totalQuantidade += mochila[i].quantidade;
-        
-        // Considera alta prioridade: valores 4 e 5
-        if(mochila[i].prioridade >= 4) {
-            prioridadeAlta++;
-        }
+    char nomeAlterar[MAX_NOME];
+    int indice;
+    int delta;
+    
+    printf("\nALTERAR QUANTIDADE DE ITEM\n");
+    printf("=============================\n");
+    printf("Digite o nome do item: ");
+    lerNome(nomeAlterar, MAX_NOME);
+    
+    if(mochilaLocalizar(m, nomeAlterar, &indice) != MOCHILA_OK) {
+        printf("\nItem '%s' nao encontrado na mochila.\n", nomeAlterar);
+        printf("Dica: Verifique se o nome esta correto ou liste os itens primeiro.\n");
+        return;
     }
     
-    // EXIBIÇÃO DE ESTATÍSTICAS CALCULADAS
-    printf("\nESTATISTICAS:\n");
-    printf("   • Total de unidades: %d\n", totalQuantidade);
-    printf("   • Itens de alta prioridade (4-5): %d\n", prioridadeAlta);
-    printf("   • Espaco disponivel: %d slots\n", MAX_ITENS - numItens);
+    printf("Quantidade atual: %d\n", m->itens[indice].quantidade);
+    printf("Variacao (positivo para adicionar, negativo para consumir): ");
+    scanf("%d", &delta);
+    
+    if(mochilaAjustarQuantidade(m, indice, delta) != MOCHILA_OK) {
+        printf("\nVariacao invalida! A quantidade nao pode ficar negativa nem exceder o limite.\n");
+        return;
+    }
+    
+    printf("\nQuantidade de '%s' atualizada para %d.\n",
+           m->itens[indice].nome, m->itens[indice].quantidade);
+}
+
+/**
+ * Alterna o modo de inserção para nomes já existentes
+ * - Ativo: a quantidade é somada ao item existente (sem duplicatas)
+ * - Inativo: comportamento clássico, o item é adicionado novamente
+ */
+void alternarModoMesclagem(Mochila *m) {
+    mochilaDefinirMesclagem(m, !m->mesclarDuplicados);
+    printf("\nMesclagem de nomes repetidos: %s\n",
+           m->mesclarDuplicados ? "ATIVADA" : "DESATIVADA");
+}
+
+/**
+ * Interface da Busca Automática por Nome
+ * 
+ * FUNCIONAMENTO:
+ * 1. Lê o nome procurado
+ * 2. mochilaBuscar escolhe a estratégia (linear, binária, Eytzinger ou hash)
+ * 3. Exibe o item, a estratégia usada e o custo em passos
+ * 
+ * VANTAGEM: Nunca força uma reordenação, ao contrário da opção 6
+ */
+void buscaAutomatica(Mochila *m) {
+    if(m->numItens == 0) {
+        printf("\nMOCHILA VAZIA! Nao ha itens para buscar.\n");
+        return;
+    }
+    
+    char nomeBuscar[MAX_NOME];
+    int indice;                     // Posição do item encontrado
+    int passos = 0;                 // Custo reportado pela biblioteca
+    EstrategiaBusca estrategia;     // Estratégia escolhida pelo despachante
+    const char *nomeEstrategia;
+    
+    printf("\nBUSCA AUTOMATICA POR NOME\n");
+    printf("============================\n");
+    printf("Digite o nome do item que deseja buscar: ");
+    lerNome(nomeBuscar, MAX_NOME);
+    
+    StatusMochila status = mochilaBuscar(m, nomeBuscar, &indice, &estrategia, &passos);
+    
+    // Binária e sequencial também respondem enquanto o índice está desatualizado
+    switch(estrategia) {
+        case BUSCA_BINARIA:
+            nomeEstrategia = m->layoutEytzinger
+                ? "busca binaria (layout Eytzinger desatualizado)"
+                : "busca binaria (mochila ordenada por nome)";
+            break;
+        case BUSCA_HASH:    nomeEstrategia = "indice hash (muitos itens sem ordenacao)"; break;
+        case BUSCA_EYTZINGER: nomeEstrategia = "layout Eytzinger (mochila ordenada por nome)"; break;
+        default:
+            nomeEstrategia = m->numItens <= LIMIAR_BUSCA_LINEAR
+                ? "busca sequencial (poucos itens)"
+                : "busca sequencial (indice hash desatualizado)";
+            break;
+    }
+    
+    printf("\nEstrategia escolhida: %s\n", nomeEstrategia);
+    
+    if(status == MOCHILA_OK) {
+        printf("\nITEM ENCONTRADO EM %d PASSOS!\n", passos);
+        printf("================================\n");
+        exibirDetalhesItem(&m->itens[indice], indice);
+    } else {
+        printf("\nITEM NAO ENCONTRADO!\n");
+        printf("========================\n");
+        printf("O item '%s' nao foi encontrado na mochila.\n", nomeBuscar);
+        printf("Busca completada em %d passos.\n", passos);
+    }
+}
+
+/**
+ * Desfaz a última inserção, remoção, alteração de quantidade, ordenação ou
+ * restauração de snapshot
+ */
+void desfazerOperacao(Mochila *m) {
+    if(mochilaDesfazer(m) == MOCHILA_OK) {
+        printf("\nOperacao desfeita! Itens na mochila: %d\n", m->numItens);
+    } else {
+        printf("\nNao ha operacao para desfazer.\n");
+    }
+}
+
+/**
+ * Reaplica a última operação desfeita (perdida se outra operação for feita antes)
+ */
+void refazerOperacao(Mochila *m) {
+    if(mochilaRefazer(m) == MOCHILA_OK) {
+        printf("\nOperacao refeita! Itens na mochila: %d\n", m->numItens);
+    } else {
+        printf("\nNao ha operacao para refazer.\n");
+    }
+}
+
+/**
+ * Guarda o estado atual da mochila com um nome (um nome repetido é sobrescrito)
+ */
+void salvarSnapshot(Mochila *m) {
+    char nome[MAX_NOME];
+    
+    printf("\nSALVAR SNAPSHOT\n");
+    printf("==================\n");
+    printf("Nome do snapshot: ");
+    lerNome(nome, MAX_NOME);
+    
+    StatusMochila status = mochilaSalvarSnapshot(m, nome);
+    if(status == MOCHILA_OK) {
+        printf("\nSnapshot '%s' salvo com %d itens.\n", nome, m->numItens);
+    } else if(status == MOCHILA_SEM_HISTORICO) {
+        printf("\nHistorico indisponivel: snapshot nao salvo.\n");
+    } else {
+        printf("\nErro: memoria insuficiente para salvar o snapshot.\n");
+    }
+}
+
+/**
+ * Volta a mochila para um snapshot salvo; a restauração pode ser desfeita (opção 10)
+ */
+void restaurarSnapshot(Mochila *m) {
+    char nome[MAX_NOME];
+    
+    printf("\nRESTAURAR SNAPSHOT\n");
+    printf("=====================\n");
+    printf("Nome do snapshot: ");
+    lerNome(nome, MAX_NOME);
+    
+    StatusMochila status = mochilaRestaurarSnapshot(m, nome);
+    if(status == MOCHILA_OK) {
+        printf("\nSnapshot '%s' restaurado! Itens na mochila: %d\n", nome, m->numItens);
+    } else if(status == MOCHILA_NAO_ENCONTRADO) {
+        printf("\nNenhum snapshot chamado '%s'.\n", nome);
+    } else if(status == MOCHILA_SEM_HISTORICO) {
+        printf("\nHistorico indisponivel.\n");
+    } else {
+        printf("\nErro: memoria insuficiente para restaurar o snapshot.\n");
+    }
 }
@@ -0,0 +1,179 @@
+/*
+ * =====================================================================================
+ * PROGRAMA: Benchmark de Busca por Nome - Codigo da Ilha
+ * DESCRICAO: Compara o tempo medio por consulta da busca binaria classica com a
+ *            busca no layout Eytzinger (e o indice hash como referencia) sobre
+ *            mochilas ordenadas por nome de tamanhos crescentes.
+ * USO: make benchmark && ./benchmark_busca
+ * =====================================================================================
+ */
+
+#include <stdio.h>      // Funcoes de entrada/saida (printf)
+#include <stdlib.h>     // Alocacao e numeros aleatorios (malloc, qsort, rand)
+#include <string.h>     // Funcoes de manipulacao de strings (strcmp, strcpy)
+#include <time.h>       // Medicao de tempo (clock)
+
+#include "mochila.h"    // Biblioteca da mochila
+
+/*
+ * =====================================================================================
+ * CONSTANTES DO BENCHMARK
+ * =====================================================================================
+ */
+#define NUM_CONSULTAS (1 << 20)     // Consultas por estrategia e tamanho
+#define TAM_NOME_MIN 6              // Tamanho minimo dos nomes gerados
+#define TAM_NOME_MAX 20             // Tamanho maximo dos nomes gerados
+
+static const int TAMANHOS[] = {1000, 100000, 1000000};  // Itens por rodada
+
+/**
+ * Assinatura comum das buscas comparadas
+ */
+typedef StatusMochila (*FuncaoBusca)(Mochila *m, const char *nome, int *indice, int *passos);
+
+/**
+ * Gera um nome aleatorio de letras minusculas com tamanho entre os limites
+ */
+static void gerarNome(char *destino) {
+    int tamanho = TAM_NOME_MIN + rand() % (TAM_NOME_MAX - TAM_NOME_MIN + 1);
+    for(int i = 0; i < tamanho; i++) {
+        destino[i] = (char)('a' + rand() % 26);
+    }
+    destino[tamanho] = '\0';
+}
+
+/**
+ * Comparador de nomes para qsort
+ */
+static int compararNomes(const void *a, const void *b) {
+    return strcmp((const char *)a, (const char *)b);
+}
+
+/**
+ * Adaptadores: a busca binaria recebe contexto constante
+ */
+static StatusMochila buscarBinaria(Mochila *m, const char *nome, int *indice, int *passos) {
+    return mochilaBuscarBinaria(m, nome, indice, passos);
+}
+
+static StatusMochila buscarDespachante(Mochila *m, const char *nome, int *indice, int *passos) {
+    return mochilaBuscar(m, nome, indice, NULL, passos);
+}
+
+/**
+ * Executa todas as consultas com uma estrategia e devolve nanossegundos por consulta
+ * @param encontrados Saida: consultas que acharam o item (evita eliminar o laco)
+ * @param passosMedios Saida: passos medios reportados pela biblioteca
+ */
+static double medir(FuncaoBusca busca, Mochila *m, char (*consultas)[MAX_NOME],
+                    long *encontrados, double *passosMedios) {
+    long achados = 0;
+    long totalPassos = 0;
+    int indice;
+    int passos;
+    
+    clock_t inicio = clock();
+    for(int q = 0; q < NUM_CONSULTAS; q++) {
+        if(busca(m, consultas[q], &indice, &passos) == MOCHILA_OK) {
+            achados++;
+        }
+        totalPassos += passos;
+    }
+    clock_t fim = clock();
+
+    *encontrados = achados;
+    *passosMedios = (double)totalPassos / NUM_CONSULTAS;
+    return (double)(fim - inicio) * 1e9 / CLOCKS_PER_SEC / NUM_CONSULTAS;
+}
+
+/**
+ * Funcao main: uma rodada por tamanho de mochila
+ *
+ * FUNCIONAMENTO:
+ * 1. Gera nomes aleatorios, ordena e remove repetidos
+ * 2. Insere em ordem (a mochila ainda nao se sabe ordenada por nome)
+ * 3. Sorteia consultas: metade nomes existentes, metade inexistentes
+ * 4. Mede o despachante (hash), ordena por nome (Insertion Sort no melhor
+ *    caso, O(n)) e mede binaria e Eytzinger
+ */
+int main() {
+    char (*nomes)[MAX_NOME];
+    char (*consultas)[MAX_NOME] = malloc((size_t)NUM_CONSULTAS * sizeof(*consultas));
+    int maiorTamanho = TAMANHOS[sizeof(TAMANHOS) / sizeof(TAMANHOS[0]) - 1];
+    
+    nomes = malloc((size_t)maiorTamanho * sizeof(*nomes));
+    if(nomes == NULL || consultas == NULL) {
+        printf("Erro: memoria insuficiente para o benchmark.\n");
+        return 1;
+    }
+    
+    srand(42);  // Semente fixa: rodadas comparaveis entre execucoes
+    
+    printf("BENCHMARK DE BUSCA POR NOME (%d consultas por estrategia)\n", NUM_CONSULTAS);
+    printf("==================================================================\n");
+    printf("%-10s %-12s %12s %10s %12s\n", "Itens", "Estrategia", "ns/consulta", "Passos", "Encontrados");
+    
+    for(size_t t = 0; t < sizeof(TAMANHOS) / sizeof(TAMANHOS[0]); t++) {
+        int n = TAMANHOS[t];
+        Mochila m;
+        
+        if(mochilaInicializar(&m, n) != MOCHILA_OK) {
+            printf("Erro: memoria insuficiente para %d itens.\n", n);
+            return 1;
+        }
+        mochilaDefinirMesclagem(&m, false);     // Nomes ja sao unicos; evita buscas na insercao
+        mochilaDefinirLayoutEytzinger(&m, true);
+        
+        // GERAÇÃO: nomes únicos em ordem crescente
+        for(int i = 0; i < n; i++) {
+            gerarNome(nomes[i]);
+        }
+        qsort(nomes, (size_t)n, sizeof(*nomes), compararNomes);
+        
+        for(int i = 0; i < n; i++) {
+            if(i > 0 && strcmp(nomes[i], nomes[i - 1]) == 0) {
+                continue;
+            }
+            Item item = {0};
+            strcpy(item.nome, nomes[i]);
+            item.quantidade = 1;
+            item.prioridade = 1 + i % 5;
+            mochilaInserir(&m, &item, NULL, NULL);
+        }
+        
+        // CONSULTAS: metade acertos, metade nomes aleatórios (quase sempre ausentes)
+        for(int q = 0; q < NUM_CONSULTAS; q++) {
+            if(q % 2 == 0) {
+                strcpy(consultas[q], m.itens[rand() % m.numItens].nome);
+            } else {
+                gerarNome(consultas[q]);
+            }
+        }
+        
+        long encontrados;
+        double passos;
+        double ns;
+        
+        // Referência: inserida sem ordenar, a mochila é atendida pelo índice hash
+        ns = medir(buscarDespachante, &m, consultas, &encontrados, &passos);
+        double nsHash = ns;
+        double passosHash = passos;
+        long encontradosHash = encontrados;
+        
+        mochilaOrdenar(&m, NOME, NULL);    // Já em ordem: O(n) e constrói o layout
+        
+        ns = medir(buscarBinaria, &m, consultas, &encontrados, &passos);
+        printf("%-10d %-12s %12.1f %10.1f %12ld\n", m.numItens, "binaria", ns, passos, encontrados);
+        
+        ns = medir(mochilaBuscarEytzinger, &m, consultas, &encontrados, &passos);
+        printf("%-10d %-12s %12.1f %10.1f %12ld\n", m.numItens, "eytzinger", ns, passos, encontrados);
+        
+        printf("%-10d %-12s %12.1f %10.1f %12ld\n", m.numItens, "hash", nsHash, passosHash, encontradosHash);
+        
+        mochilaLiberar(&m);
+    }
+    
+    free(nomes);
+    free(consultas);
+    return 0;
+}
@@ -0,0 +1,1583 @@
+/*
+ * =====================================================================================
+ * BIBLIOTECA: Mochila - Nucleo do Codigo da Ilha
+ * DESCRICAO: Implementacao das operacoes da mochila declaradas em mochila.h
+ *            Nenhuma funcao deste arquivo le do teclado ou escreve no console.
+ * =====================================================================================
+ */
+
+#include <limits.h>     // Limites dos tipos inteiros (INT_MAX)
+#include <stdint.h>     // Aritmetica de enderecos (uintptr_t)
+#include <stdlib.h>     // Alocacao de memoria (malloc, free)
+#include <string.h>     // Funcoes de manipulacao de strings (strcmp, memmove)
+
+#include "mochila.h"
+
+/*
+ * Prefetch da descida Eytzinger: disponível em GCC/Clang, no-op nos demais
+ */
+#if defined(__GNUC__)
+    #define PREFETCH(endereco) __builtin_prefetch(endereco)
+#else
+    #define PREFETCH(endereco) ((void)0)
+#endif
+
+#define LINHA_CACHE 64  // Bytes por linha de cache (alinhamento do layout Eytzinger)
+
+/*
+ * =====================================================================================
+ * HISTORICO: tipos e funcoes implementados ao final do arquivo
+ * =====================================================================================
+ */
+typedef struct NoVersao NoVersao;
+
+/**
+ * Enumeracao OperacaoVersao: O que mudou de uma versao para a seguinte
+ */
+typedef enum {
+    VERSAO_INICIAL,     // Conteudo no momento em que o historico foi ligado
+    VERSAO_INSERIR,     // Item entrou na posicao registrada
+    VERSAO_REMOVER,     // Item saiu da posicao registrada
+    VERSAO_ALTERAR,     // Item da posicao registrada mudou (quantidade)
+    VERSAO_SUBSTITUIR,  // Vetor inteiro mudou (ordenacao ou snapshot)
+    VERSAO_MARCAR       // So a flag de ordenacao mudou (mesma arvore)
+} OperacaoVersao;
+
+static StatusMochila prepararVersao(Mochila *m, OperacaoVersao operacao, int posicao,
+                                    const Item *item, NoVersao **raiz);
+static void confirmarVersao(Mochila *m, NoVersao *raiz, OperacaoVersao operacao, int posicao);
+static void restaurarVersaoAtual(Mochila *m);
+
+/*
+ * =====================================================================================
+ * FUNCOES AUXILIARES INTERNAS
+ * =====================================================================================
+ */
+
+/**
+ * Função para comparar dois itens baseado no critério de ordenação
+ * @param a Primeiro item a ser comparado
+ * @param b Segundo item a ser comparado
+ * @param criterio Critério de comparação (NOME, TIPO ou PRIORIDADE)
+ * @return Valor negativo se a < b, positivo se a > b, zero se iguais
+ */
+static int compararItens(const Item *a, const Item *b, CriterioOrdenacao criterio) {
+    switch(criterio) {
+        case NOME:
+            // Comparação lexicográfica dos nomes (A-Z)
+            return strcmp(a->nome, b->nome);
+        case TIPO:
+            // Comparação lexicográfica dos tipos (A-Z)
+            return strcmp(a->tipo, b->tipo);
+        case PRIORIDADE:
+            // Ordenação decrescente (prioridade mais alta primeiro)
+            return b->prioridade - a->prioridade;
+        default:
+            return 0;   // Caso padrão: itens considerados iguais
+    }
+}
+
+/**
+ * Atualiza os agregados ao entrar (sinal = +1) ou sair (sinal = -1) um item
+ */
+static void atualizarAgregados(Mochila *m, const Item *item, int sinal) {
+    m->totalUnidades += sinal * item->quantidade;
+    if(item->prioridade >= 4) {
+        m->itensAltaPrioridade += sinal;
+    }
+}
+
+/**
+ * Função hash FNV-1a (32 bits) sobre o nome do item
+ */
+static unsigned int hashNome(const char *nome) {
+    unsigned int h = 2166136261u;
+    while(*nome) {
+        h ^= (unsigned char)*nome++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * Registra a posição 'indice' na tabela hash (sondagem linear)
+ * Chamada só com ocupação de no máximo metade da tabela: sempre há posição livre.
+ */
+static void registrarNoHash(Mochila *m, int indice) {
+    unsigned int mascara = (unsigned int)m->tamanhoHash - 1;
+    unsigned int pos = hashNome(m->itens[indice].nome) & mascara;
+    
+    while(m->indiceHash[pos] != -1) {
+        pos = (pos + 1) & mascara;
+    }
+    m->indiceHash[pos] = indice;
+}
+
+/**
+ * Reconstrói a tabela hash a partir do vetor atual, O(n)
+ * A tabela acompanha numItens (não a capacidade): é realocada quando fica
+ * pequena demais ou quatro vezes maior que o necessário, então limpá-la custa
+ * O(numItens) mesmo numa mochila de capacidade enorme.
+ * @return MOCHILA_OK ou MOCHILA_SEM_MEMORIA
+ */
+static StatusMochila reconstruirHash(Mochila *m) {
+    int tamanho = 2 * LIMIAR_BUSCA_LINEAR;
+    while(tamanho < 2 * m->numItens) {
+        tamanho <<= 1;      // Potência de 2: módulo vira máscara de bits
+    }
+    
+    if(m->tamanhoHash < tamanho || m->tamanhoHash > 4 * tamanho) {
+        int *tabela = realloc(m->indiceHash, (size_t)tamanho * sizeof(int));
+        if(tabela == NULL) {
+            return MOCHILA_SEM_MEMORIA;
+        }
+        m->indiceHash = tabela;
+        m->tamanhoHash = tamanho;
+    }
+    
+    memset(m->indiceHash, 0xFF, (size_t)m->tamanhoHash * sizeof(int));   // Tudo -1
+    // Inserção em ordem crescente: nomes repetidos devolvem a primeira ocorrência
+    for(int i = 0; i < m->numItens; i++) {
+        registrarNoHash(m, i);
+    }
+    m->hashValido = true;
+    return MOCHILA_OK;
+}
+
+/**
+ * Marca a tabela hash como desatualizada e reinicia a contagem de buscas lineares
+ */
+static void invalidarHash(Mochila *m) {
+    m->hashValido = false;
+    m->buscasSemHash = 0;
+}
+
+/**
+ * Prefixo de 8 bytes do nome em big-endian
+ * A ordem dos prefixos acompanha a ordem de strcmp (bytes sem sinal), então
+ * prefixos iguais só podem vir de nomes vizinhos no vetor ordenado.
+ */
+static uint64_t prefixoNome(const char *nome) {
+    uint64_t chave = 0;
+    bool fim = false;
+    
+    // Após o '\0' completa com zeros, como strcmp; deslocamento sempre de 8 bits
+    for(int i = 0; i < 8; i++) {
+        fim = fim || nome[i] == '\0';
+        chave = (chave << 8) | (fim ? 0u : (unsigned char)nome[i]);
+    }
+    return chave;
+}
+
+/**
+ * Preenche o layout Eytzinger por percurso em ordem (recursivo, profundidade log n)
+ * @param i Próxima posição do vetor ordenado a ser consumida
+ * @param k Nó atual da árvore implícita (filhos em 2k e 2k+1)
+ * @return Próxima posição do vetor ordenado após a subárvore de k
+ */
+static int preencherEytzinger(Mochila *m, int i, int k) {
+    if(k <= m->numItens) {
+        i = preencherEytzinger(m, i, 2 * k);
+        m->eytzChave[k] = prefixoNome(m->itens[i].nome);
+        m->eytzPosicao[k] = i;
+        i++;
+        i = preencherEytzinger(m, i, 2 * k + 1);
+    }
+    return i;
+}
+
+/**
+ * Aloca 'tamanho' bytes com início alinhado a LINHA_CACHE (C99 puro, sem
+ * aligned_alloc): sobra de uma linha, e o ponteiro original fica guardado logo
+ * antes do bloco alinhado para liberarAlinhado.
+ */
+static void *alocarAlinhado(size_t tamanho) {
+    char *bruto = malloc(tamanho + sizeof(void *) + LINHA_CACHE - 1);
+    if(bruto == NULL) {
+        return NULL;
+    }
+    
+    uintptr_t endereco = (uintptr_t)(bruto + sizeof(void *));
+    endereco = (endereco + LINHA_CACHE - 1) & ~(uintptr_t)(LINHA_CACHE - 1);
+    ((void **)endereco)[-1] = bruto;
+    return (void *)endereco;
+}
+
+static void liberarAlinhado(void *bloco) {
+    if(bloco != NULL) {
+        free(((void **)bloco)[-1]);
+    }
+}
+
+/**
+ * Marca o layout Eytzinger como desatualizado e reinicia a contagem de buscas binárias
+ */
+static void invalidarEytzinger(Mochila *m) {
+    m->eytzValido = false;
+    m->buscasSemEytzinger = 0;
+}
+
+/**
+ * Libera os vetores do layout Eytzinger e o marca como inválido
+ */
+static void liberarEytzinger(Mochila *m) {
+    liberarAlinhado(m->eytzChave);
+    free(m->eytzPosicao);
+    m->eytzChave = NULL;
+    m->eytzPosicao = NULL;
+    invalidarEytzinger(m);
+}
+
+/**
+ * Reconstrói o layout Eytzinger a partir do vetor ordenado por nome, O(n)
+ * Os vetores são alocados na primeira chamada com capacidade + 1 posições;
+ * eytzChave começa numa linha de cache, de modo que chave[8k..8k+7] (os
+ * descendentes de k três níveis abaixo) ocupam exatamente uma linha.
+ * @return MOCHILA_OK ou MOCHILA_SEM_MEMORIA
+ */
+static StatusMochila reconstruirEytzinger(Mochila *m) {
+    if(m->eytzChave == NULL) {
+        m->eytzChave = alocarAlinhado((size_t)(m->capacidade + 1) * sizeof(uint64_t));
+        m->eytzPosicao = malloc((size_t)(m->capacidade + 1) * sizeof(int));
+        if(m->eytzChave == NULL || m->eytzPosicao == NULL) {
+            liberarEytzinger(m);
+            return MOCHILA_SEM_MEMORIA;
+        }
+    }
+    
+    preencherEytzinger(m, 0, 1);
+    m->eytzValido = true;
+    return MOCHILA_OK;
+}
+
+/**
+ * Abre espaço na posição 'posicao' e grava o item (deslocamento à direita)
+ * Atualiza agregados; o índice hash segue válido só quando o item vai para o final.
+ */
+static void visaoInserir(Mochila *m, int posicao, const Item *item) {
+    memmove(&m->itens[posicao + 1], &m->itens[posicao],
+            (size_t)(m->numItens - posicao) * sizeof(Item));
+    m->itens[posicao] = *item;
+    m->numItens++;
+    atualizarAgregados(m, item, +1);
+    
+    if(m->hashValido && posicao == m->numItens - 1 && 2 * m->numItens <= m->tamanhoHash) {
+        registrarNoHash(m, posicao);    // Índice hash segue válido em O(1)
+    } else {
+        invalidarHash(m);
+    }
+    invalidarEytzinger(m);
+}
+
+/**
+ * Retira o item da posição 'posicao' (deslocamento à esquerda)
+ * A ordem relativa dos demais itens é preservada.
+ */
+static void visaoRemover(Mochila *m, int posicao) {
+    atualizarAgregados(m, &m->itens[posicao], -1);
+    memmove(&m->itens[posicao], &m->itens[posicao + 1],
+            (size_t)(m->numItens - posicao - 1) * sizeof(Item));
+    m->numItens--;
+    invalidarHash(m);
+    invalidarEytzinger(m);
+}
+
+/**
+ * Substitui o item da posição 'posicao' no próprio lugar
+ * Índices por nome só são invalidados se o nome mudar.
+ */
+static void visaoAlterar(Mochila *m, int posicao, const Item *item) {
+    if(strcmp(m->itens[posicao].nome, item->nome) != 0) {
+        invalidarHash(m);
+        invalidarEytzinger(m);
+    }
+    atualizarAgregados(m, &m->itens[posicao], -1);
+    m->itens[posicao] = *item;
+    atualizarAgregados(m, item, +1);
+}
+
+/*
+ * =====================================================================================
+ * CICLO DE VIDA
+ * =====================================================================================
+ */
+
+/**
+ * Inicializa uma mochila vazia com a capacidade informada
+ * @return MOCHILA_OK, MOCHILA_ARGUMENTO_INVALIDO ou MOCHILA_SEM_MEMORIA
+ */
+StatusMochila mochilaInicializar(Mochila *m, int capacidade) {
+    if(m == NULL || capacidade <= 0) {
+        return MOCHILA_ARGUMENTO_INVALIDO;
+    }
+    
+    m->itens = malloc((size_t)capacidade * sizeof(Item));
+    if(m->itens == NULL) {
+        return MOCHILA_SEM_MEMORIA;
+    }
+    
+    m->numItens = 0;
+    m->capacidade = capacidade;
+    m->ordenadaPorNome = false;
+    m->mesclarDuplicados = true;
+    m->totalUnidades = 0;
+    m->itensAltaPrioridade = 0;
+    m->indiceHash = NULL;       // Criado apenas quando a busca hash for escolhida
+    m->tamanhoHash = 0;
+    m->hashValido = false;
+    m->buscasSemHash = 0;
+    m->layoutEytzinger = false; // Opcional: custa 12 bytes por posição de capacidade
+    m->eytzChave = NULL;
+    m->eytzPosicao = NULL;
+    m->eytzValido = false;
+    m->buscasSemEytzinger = 0;
+    m->historico = NULL;        // Versionamento desligado até mochilaHabilitarHistorico
+    return MOCHILA_OK;
+}
+
+/**
+ * Libera o vetor de itens; o contexto pode ser reinicializado depois
+ */
+void mochilaLiberar(Mochila *m) {
+    if(m == NULL) {
+        return;
+    }
+    mochilaDesabilitarHistorico(m);
+    free(m->itens);
+    free(m->indiceHash);
+    liberarEytzinger(m);
+    m->itens = NULL;
+    m->indiceHash = NULL;
+    m->tamanhoHash = 0;
+    m->hashValido = false;
+    m->numItens = 0;
+    m->capacidade = 0;
+}
+
+/*
+ * =====================================================================================
+ * CONFIGURACAO
+ * =====================================================================================
+ */
+
+/**
+ * Define o modo de inserção de nomes repetidos
+ * Não altera o conteúdo, portanto não gera versão no histórico.
+ */
+StatusMochila mochilaDefinirMesclagem(Mochila *m, bool ativa) {
+    if(m == NULL) {
+        return MOCHILA_ARGUMENTO_INVALIDO;
+    }
+    m->mesclarDuplicados = ativa;
+    return MOCHILA_OK;
+}
+
+/**
+ * Define se a visão ordenada por nome também é mantida em layout Eytzinger
+ * Ligar apenas marca o layout como inválido (construção sob demanda, O(n));
+ * desligar devolve os 12 bytes por posição de capacidade do layout.
+ */
+StatusMochila mochilaDefinirLayoutEytzinger(Mochila *m, bool ativo) {
+    if(m == NULL) {
+        return MOCHILA_ARGUMENTO_INVALIDO;
+    }
+    if(!ativo) {
+        liberarEytzinger(m);
+    }
+    m->layoutEytzinger = ativo;
+    invalidarEytzinger(m);
+    return MOCHILA_OK;
+}
+
+/*
+ * =====================================================================================
+ * OPERACOES
+ * =====================================================================================
+ */
+
+/**
+ * Insere um item no final da mochila
+ *
+ * VALIDAÇÕES (valem também para a mesclagem, que nunca decrementa):
+ * - Prioridade entre 1 e 5, quantidade não negativa
+ * - Com mesclarDuplicados ativo, nome existente apenas soma a quantidade
+ *   (funciona mesmo com a mochila cheia e preserva a ordenação)
+ * - Nome novo exige espaço disponível
+ *
+ * EFEITOS: item novo desabilita ordenadaPorNome; agregados atualizados em O(1);
+ * com histórico ligado, grava uma versão (O(log n) nós)
+ */
+StatusMochila mochilaInserir(Mochila *m, const Item *item, int *indice, bool *mesclado) {
+    if(m == NULL || item == NULL) {
+        return MOCHILA_ARGUMENTO_INVALIDO;
+    }
+    if(mesclado != NULL) {
+        *mesclado = false;
+    }
+    if(item->prioridade < 1 || item->prioridade > 5) {
+        return MOCHILA_PRIORIDADE_INVALIDA;
+    }
+    if(item->quantidade < 0) {
+        return MOCHILA_QUANTIDADE_INVALIDA;
+    }
+    
+    // MESCLAGEM: nome já existente apenas recebe a nova quantidade; só a
+    // ausência confirmada (NAO_ENCONTRADO) segue para a inserção de item novo
+    if(m->mesclarDuplicados) {
+        int existente;
+        StatusMochila status = mochilaLocalizar(m, item->nome, &existente);
+        if(status != MOCHILA_OK && status != MOCHILA_NAO_ENCONTRADO) {
+            return status;
+        }
+        if(status == MOCHILA_OK) {
+            status = mochilaAjustarQuantidade(m, existente, item->quantidade);
+            if(status == MOCHILA_OK) {
+                if(indice != NULL) {
+                    *indice = existente;
+                }
+                if(mesclado != NULL) {
+                    *mesclado = true;
+                }
+            }
+            return status;
+        }
+    }
+    
+    if(item->quantidade > INT_MAX - m->totalUnidades) {
+        return MOCHILA_QUANTIDADE_INVALIDA;
+    }
+    if(m->numItens >= m->capacidade) {
+        return MOCHILA_CHEIA;
+    }
+    
+    int posicao = m->numItens;      // Próxima posição disponível
+    NoVersao *versao;
+    StatusMochila status = prepararVersao(m, VERSAO_INSERIR, posicao, item, &versao);
+    if(status != MOCHILA_OK) {
+        return status;
+    }
+    
+    visaoInserir(m, posicao, item);
+    m->ordenadaPorNome = false;     // Item novo no final quebra a ordem por nome
+    confirmarVersao(m, versao, VERSAO_INSERIR, posicao);
+    
+    if(indice != NULL) {
+        *indice = posicao;
+    }
+    return MOCHILA_OK;
+}
+
+/**
+ * Remove um item pelo nome
+ *
+ * ALGORITMO: localização + deslocamento à esquerda (memmove), O(n).
+ * A ordem relativa dos demais itens é preservada, logo ordenadaPorNome se mantém.
+ * As posições mudam, então o índice hash e o layout Eytzinger são invalidados.
+ */
+StatusMochila mochilaRemover(Mochila *m, const char *nome, Item *removido) {
+    if(m == NULL || nome == NULL) {
+        return MOCHILA_ARGUMENTO_INVALIDO;
+    }
+    if(m->numItens == 0) {
+        return MOCHILA_VAZIA;
+    }
+    
+    int indice;
+    StatusMochila status = mochilaLocalizar(m, nome, &indice);
+    if(status != MOCHILA_OK) {
+        return status;
+    }
+    
+    NoVersao *versao;
+    status = prepararVersao(m, VERSAO_REMOVER, indice, NULL, &versao);
+    if(status != MOCHILA_OK) {
+        return status;
+    }
+    
+    if(removido != NULL) {
+        *removido = m->itens[indice];
+    }
+    
+    // SHIFT LEFT: mantém a contiguidade do vetor sem "buracos"
+    visaoRemover(m, indice);
+    confirmarVersao(m, versao, VERSAO_REMOVER, indice);
+    return MOCHILA_OK;
+}
+
+/**
+ * Altera a quantidade de um item no próprio lugar
+ *
+ * Nenhum critério de ordenação usa a quantidade, portanto a posição do item
+ * e a flag ordenadaPorNome continuam válidas. O agregado é corrigido em O(1).
+ * Resultado negativo ou acima de INT_MAX (no item ou no total de unidades)
+ * devolve MOCHILA_QUANTIDADE_INVALIDA sem alterar nada.
+ */
+StatusMochila mochilaAjustarQuantidade(Mochila *m, int indice, int delta) {
+    if(m == NULL || indice < 0 || indice >= m->numItens) {
+        return MOCHILA_ARGUMENTO_INVALIDO;
+    }
+    
+    // Quantidades e total nunca são negativos: só um delta positivo pode estourar
+    if(delta > 0 && (delta > INT_MAX - m->itens[indice].quantidade ||
+                     delta > INT_MAX - m->totalUnidades)) {
+        return MOCHILA_QUANTIDADE_INVALIDA;
+    }
+    
+    int novaQuantidade = m->itens[indice].quantidade + delta;
+    if(novaQuantidade < 0) {
+        return MOCHILA_QUANTIDADE_INVALIDA;   // Não existe quantidade negativa
+    }
+    if(delta == 0) {
+        return MOCHILA_OK;      // Nada muda: não gera versão no histórico
+    }
+    
+    Item alterado = m->itens[indice];
+    alterado.quantidade = novaQuantidade;
+    
+    NoVersao *versao;
+    StatusMochila status = prepararVersao(m, VERSAO_ALTERAR, indice, &alterado, &versao);
+    if(status != MOCHILA_OK) {
+        return status;
+    }
+    
+    visaoAlterar(m, indice, &alterado);
+    confirmarVersao(m, versao, VERSAO_ALTERAR, indice);
+    return MOCHILA_OK;
+}
+
+/**
+ * Algoritmo de Ordenação por Inserção (Insertion Sort)
+ *
+ * COMPLEXIDADE:
+ * - Melhor caso: O(n) - array já ordenado
+ * - Pior caso: O(n²) - array ordenado inversamente
+ *
+ * EFEITOS: ordenadaPorNome passa a refletir se o critério foi NOME;
+ * o índice hash é invalidado (posições permutadas) e, ordenando por nome com
+ * layoutEytzinger ativo, o layout Eytzinger é reconstruído junto (se faltar
+ * memória para ele, fica para a próxima busca).
+ * Com histórico ligado, a nova ordem vira uma versão de O(n) nós (nenhum, se
+ * nada se moveu); se não houver memória para ela, a ordem anterior é
+ * restaurada e nada muda.
+ */
+StatusMochila mochilaOrdenar(Mochila *m, CriterioOrdenacao criterio, int *comparacoes) {
+    if(m == NULL || criterio < NOME || criterio > PRIORIDADE) {
+        return MOCHILA_ARGUMENTO_INVALIDO;
+    }
+    
+    int contador = 0;   // Comparações para análise de desempenho
+    bool moveu = false; // Algum item mudou de posição
+    
+    for(int i = 1; i < m->numItens; i++) {
+        Item chave = m->itens[i];   // Elemento a ser inserido na posição correta
+        int j = i - 1;              // Último elemento da parte ordenada
+        
+        // Move elementos maiores que a chave uma posição à direita
+        while(j >= 0) {
+            contador++;
+            if(compararItens(&m->itens[j], &chave, criterio) <= 0) {
+                break;
+            }
+            m->itens[j + 1] = m->itens[j];
+            j--;
+            moveu = true;
+        }
+        m->itens[j + 1] = chave;
+    }
+    
+    bool ordenadaAntes = m->ordenadaPorNome;
+    m->ordenadaPorNome = (criterio == NOME);
+    if(moveu) {
+        invalidarHash(m);
+        invalidarEytzinger(m);
+    }
+    
+    // Nada se moveu: só uma troca de flag é registrada, e sem nós novos
+    if(moveu || m->ordenadaPorNome != ordenadaAntes) {
+        OperacaoVersao operacao = moveu ? VERSAO_SUBSTITUIR : VERSAO_MARCAR;
+        NoVersao *versao;
+        StatusMochila status = prepararVersao(m, operacao, 0, NULL, &versao);
+        if(status != MOCHILA_OK) {
+            restaurarVersaoAtual(m);    // Desfaz a ordenação no vetor
+            return status;
+        }
+        confirmarVersao(m, versao, operacao, 0);
+    }
+    
+    // Sem memória para o layout, ele fica inválido e é refeito sob demanda:
+    // a ordenação já foi aplicada e registrada, então não é uma falha
+    if(m->ordenadaPorNome && m->layoutEytzinger && !m->eytzValido) {
+        reconstruirEytzinger(m);
+    }
+    if(comparacoes != NULL) {
+        *comparacoes = contador;
+    }
+    return MOCHILA_OK;
+}
+
+/*
+ * =====================================================================================
+ * BUSCAS
+ * =====================================================================================
+ */
+
+/**
+ * Busca sequencial: percorre o vetor do início ao fim, O(n)
+ * Funciona com dados não ordenados.
+ */
+StatusMochila mochilaBuscarSequencial(const Mochila *m, const char *nome, int *indice, int *passos) {
+    if(m == NULL || nome == NULL || indice == NULL) {
+        return MOCHILA_ARGUMENTO_INVALIDO;
+    }
+    
+    int i;
+    for(i = 0; i < m->numItens; i++) {
+        // Filtro barato no primeiro caractere antes da chamada a strcmp
+        if(m->itens[i].nome[0] == nome[0] && strcmp(m->itens[i].nome, nome) == 0) {
+            break;  // Primeira ocorrência
+        }
+    }
+    
+    if(passos != NULL) {
+        *passos = (i < m->numItens) ? i + 1 : m->numItens;
+    }
+    if(i == m->numItens) {
+        return MOCHILA_NAO_ENCONTRADO;
+    }
+    *indice = i;
+    return MOCHILA_OK;
+}
+
+/**
+ * Busca binária: elimina metade dos candidatos a cada passo, O(log n)
+ * PRÉ-REQUISITO: mochila ordenada por nome
+ */
+StatusMochila mochilaBuscarBinaria(const Mochila *m, const char *nome, int *indice, int *passos) {
+    if(m == NULL || nome == NULL || indice == NULL) {
+        return MOCHILA_ARGUMENTO_INVALIDO;
+    }
+    if(!m->ordenadaPorNome) {
+        return MOCHILA_NAO_ORDENADA;
+    }
+    
+    int esquerda = 0;               // Limite esquerdo
+    int direita = m->numItens - 1;  // Limite direito
+    int contador = 0;               // Passos para análise de desempenho
+    StatusMochila status = MOCHILA_NAO_ENCONTRADO;
+    
+    while(esquerda <= direita) {
+        contador++;
+        int meio = esquerda + (direita - esquerda) / 2;
+        int comparacao = strcmp(m->itens[meio].nome, nome);
+        
+        if(comparacao == 0) {
+            *indice = meio;
+            status = MOCHILA_OK;
+            break;
+        } else if(comparacao < 0) {
+            esquerda = meio + 1;    // Metade direita
+        } else {
+            direita = meio - 1;     // Metade esquerda
+        }
+    }
+    
+    if(passos != NULL) {
+        *passos = contador;
+    }
+    return status;
+}
+
+/**
+ * Busca no layout Eytzinger (Khuong & Morin)
+ *
+ * FUNCIONAMENTO:
+ * 1. Desce a árvore implícita comparando apenas prefixos de 8 bytes:
+ *    k = 2k + (chave[k] < alvo), sem desvio condicional; os descendentes de k
+ *    três níveis abaixo (8k..8k+7) ocupam uma linha de cache (eytzChave é
+ *    alocado alinhado) e são buscados antecipadamente com prefetch
+ * 2. Os bits 1 finais de k indicam as descidas à direita após o último
+ *    nó >= alvo; removê-los dá o limite inferior (primeiro prefixo >= alvo)
+ * 3. A partir dele, strcmp só nos nomes com o mesmo prefixo
+ *
+ * PRÉ-REQUISITO: mochila ordenada por nome (layout reconstruído se preciso)
+ */
+StatusMochila mochilaBuscarEytzinger(Mochila *m, const char *nome, int *indice, int *passos) {
+    if(m == NULL || nome == NULL || indice == NULL) {
+        return MOCHILA_ARGUMENTO_INVALIDO;
+    }
+    if(!m->ordenadaPorNome) {
+        return MOCHILA_NAO_ORDENADA;
+    }
+    if(!m->eytzValido) {
+        StatusMochila status = reconstruirEytzinger(m);
+        if(status != MOCHILA_OK) {
+            return status;
+        }
+    }
+    
+    uint64_t alvo = prefixoNome(nome);
+    const uint64_t *chave = m->eytzChave;
+    int n = m->numItens;
+    int contador = 0;
+    int k = 1;
+    
+    // DESCIDA SEM DESVIOS
+    while(k <= n) {
+        PREFETCH(chave + 8 * k);
+        k = 2 * k + (chave[k] < alvo);
+        contador++;
+    }
+    
+    // LIMITE INFERIOR: descarta as descidas à direita finais e a última à esquerda
+    while(k & 1) {
+        k >>= 1;
+    }
+    k >>= 1;
+    
+    StatusMochila status = MOCHILA_NAO_ENCONTRADO;
+    if(k != 0) {
+        // CONFIRMAÇÃO: nomes com o mesmo prefixo são vizinhos no vetor ordenado
+        for(int i = m->eytzPosicao[k]; i < n; i++) {
+            if(prefixoNome(m->itens[i].nome) != alvo) {
+                break;
+            }
+            contador++;
+            int comparacao = strcmp(m->itens[i].nome, nome);
+            if(comparacao == 0) {
+                *indice = i;
+                status = MOCHILA_OK;
+                break;
+            }
+            if(comparacao > 0) {
+                break;  // Passou do ponto: o nome não existe
+            }
+        }
+    }
+    
+    if(passos != NULL) {
+        *passos = contador;
+    }
+    return status;
+}
+
+/**
+ * Busca pelo índice hash: O(1) esperado após a construção da tabela
+ * Cada sondagem que encontra uma posição ocupada conta como um passo; se a
+ * busca precisou reconstruir a tabela, os numItens registros também contam.
+ */
+static StatusMochila buscarHash(Mochila *m, const char *nome, int *indice, int *passos) {
+    int contador = 0;
+    StatusMochila status = MOCHILA_NAO_ENCONTRADO;
+    
+    if(!m->hashValido) {
+        status = reconstruirHash(m);
+        if(status != MOCHILA_OK) {
+            return status;
+        }
+        status = MOCHILA_NAO_ENCONTRADO;
+        contador = m->numItens;
+    }
+    
+    unsigned int mascara = (unsigned int)m->tamanhoHash - 1;
+    unsigned int pos = hashNome(nome) & mascara;
+    
+    while(m->indiceHash[pos] != -1) {
+        contador++;
+        if(strcmp(m->itens[m->indiceHash[pos]].nome, nome) == 0) {
+            *indice = m->indiceHash[pos];
+            status = MOCHILA_OK;
+            break;
+        }
+        pos = (pos + 1) & mascara;
+    }
+    
+    if(passos != NULL) {
+        *passos = contador;
+    }
+    return status;
+}
+
+/**
+ * Despachante de busca: escolhe a estratégia mais barata para o estado atual
+ *
+ * DECISÃO:
+ * 1. Poucos itens (<= LIMIAR_BUSCA_LINEAR): linear - sem custo de preparo
+ * 2. Ordenada por nome: Eytzinger (se layoutEytzinger) ou binária, O(log n),
+ *    sem reordenar nada. Com o layout desatualizado, as BUSCAS_ANTES_DO_INDICE
+ *    buscas seguintes são binárias e só então ele é reconstruído
+ * 3. Muitos itens sem ordenação: hash, O(1) esperado. Depois de remoção ou
+ *    ordenação a tabela fica desatualizada; as BUSCAS_ANTES_DO_INDICE buscas
+ *    seguintes são lineares (cada uma custa no máximo o mesmo que reconstruir)
+ *    e só então a tabela é reconstruída. Assim um laço de remoções, que
+ *    invalida o índice a cada passo, nunca paga reconstruções inúteis.
+ *
+ * Falta de memória para construir um índice nunca faz a busca falhar: ela
+ * recai na estratégia sem índice (binária ou linear), e a estratégia
+ * informada é a que de fato respondeu.
+ */
+StatusMochila mochilaBuscar(Mochila *m, const char *nome, int *indice,
+                            EstrategiaBusca *estrategia, int *passos) {
+    if(m == NULL || nome == NULL || indice == NULL) {
+        return MOCHILA_ARGUMENTO_INVALIDO;
+    }
+    
+    EstrategiaBusca escolhida;
+    StatusMochila status;
+    
+    if(m->numItens <= LIMIAR_BUSCA_LINEAR) {
+        escolhida = BUSCA_LINEAR;
+        status = mochilaBuscarSequencial(m, nome, indice, passos);
+    } else if(m->ordenadaPorNome && m->layoutEytzinger &&
+              (m->eytzValido || m->buscasSemEytzinger >= BUSCAS_ANTES_DO_INDICE)) {
+        escolhida = BUSCA_EYTZINGER;
+        status = mochilaBuscarEytzinger(m, nome, indice, passos);
+        if(status == MOCHILA_SEM_MEMORIA) {
+            escolhida = BUSCA_BINARIA;  // Sem memória para o layout: binária não aloca
+            status = mochilaBuscarBinaria(m, nome, indice, passos);
+        }
+    } else if(m->ordenadaPorNome) {
+        if(m->layoutEytzinger) {
+            m->buscasSemEytzinger++;    // Layout desatualizado: adia a reconstrução
+        }
+        escolhida = BUSCA_BINARIA;
+        status = mochilaBuscarBinaria(m, nome, indice, passos);
+    } else if(!m->hashValido && m->buscasSemHash < BUSCAS_ANTES_DO_INDICE) {
+        m->buscasSemHash++;
+        escolhida = BUSCA_LINEAR;
+        status = mochilaBuscarSequencial(m, nome, indice, passos);
+    } else {
+        escolhida = BUSCA_HASH;
+        status = buscarHash(m, nome, indice, passos);
+        if(status == MOCHILA_SEM_MEMORIA) {
+            escolhida = BUSCA_LINEAR;   // Sem memória para a tabela: linear não aloca
+            status = mochilaBuscarSequencial(m, nome, indice, passos);
+        }
+    }
+    
+    if(estrategia != NULL) {
+        *estrategia = escolhida;
+    }
+    return status;
+}
+
+/**
+ * Localiza um item com a busca mais barata para o estado atual (ver mochilaBuscar)
+ */
+StatusMochila mochilaLocalizar(Mochila *m, const char *nome, int *indice) {
+    return mochilaBuscar(m, nome, indice, NULL, NULL);
+}
+
+/*
+ * =====================================================================================
+ * HISTORICO (VERSOES PERSISTENTES)
+ * =====================================================================================
+ */
+#define NOS_POR_BLOCO 256       // Nós alocados de uma vez pela arena do histórico
+#define VERSOES_INICIAIS 16     // Capacidade inicial do vetor de versões
+
+/**
+ * Estrutura NoVersao: Nó de uma treap implícita persistente
+ * A chave é a posição (tamanho da subárvore esquerda); 'peso' mantém o heap
+ * aleatório que garante altura O(log n) esperada. Nós nunca são alterados depois
+ * de publicados em uma versão: toda mudança copia o caminho até a raiz.
+ */
+struct NoVersao {
+    Item item;                  // Conteúdo da posição
+    NoVersao *esquerda;         // Posições anteriores
+    NoVersao *direita;          // Posições posteriores
+    int tamanho;                // Nós na subárvore
+    unsigned int peso;          // Prioridade do heap (sorteada)
+};
+
+/**
+ * Estrutura BlocoNos: Arena de nós
+ * Nós não são liberados um a um: compactarHistorico copia os vivos para blocos
+ * novos e devolve os antigos inteiros.
+ */
+typedef struct BlocoNos {
+    struct BlocoNos *proximo;   // Bloco alocado anteriormente
+    int usados;                 // Nós já entregues deste bloco
+    NoVersao nos[NOS_POR_BLOCO];
+} BlocoNos;
+
+/**
+ * Estrutura Versao: Uma entrada da linha do tempo
+ * @raiz: Conteúdo completo da mochila nesta versão (compartilhado)
+ * @operacao/@posicao: Diferença em relação à versão anterior
+ */
+typedef struct {
+    NoVersao *raiz;             // Árvore desta versão
+    OperacaoVersao operacao;    // Mudança que gerou a versão
+    int posicao;                // Posição afetada (INSERIR/REMOVER/ALTERAR)
+    bool ordenadaPorNome;       // Flag de ordenação nesta versão
+} Versao;
+
+/**
+ * Estrutura Snapshot: Versão guardada com nome
+ */
+typedef struct {
+    char nome[MAX_NOME];        // Nome do snapshot
+    NoVersao *raiz;             // Árvore compartilhada com a versão salva
+    bool ordenadaPorNome;       // Flag de ordenação salva
+} Snapshot;
+
+struct HistoricoMochila {
+    BlocoNos *blocos;           // Arena de nós (lista de blocos)
+    BlocoNos *reserva;          // Blocos pré-alocados para a compactação
+    size_t nosAlocados;         // Nós entregues pela arena (vivos ou não)
+    size_t nosVivos;            // Nós alcançáveis na última compactação
+    Versao *versoes;            // Linha do tempo (0 = versão inicial)
+    int numVersoes;             // Versões válidas (inclui as que podem ser refeitas)
+    int capacidadeVersoes;      // Posições alocadas em 'versoes'
+    int atual;                  // Versão refletida no vetor da mochila
+    Snapshot *snapshots;        // Snapshots nomeados
+    int numSnapshots;           // Snapshots guardados
+    int capacidadeSnapshots;    // Posições alocadas em 'snapshots'
+    unsigned int semente;       // Estado do gerador xorshift dos pesos
+    bool semMemoria;            // Alguma alocação falhou na operação corrente
+};
+
+/**
+ * Entrega um nó da arena (NULL e semMemoria = true em caso de falha)
+ */
+static NoVersao *novoNo(HistoricoMochila *h) {
+    if(h->blocos == NULL || h->blocos->usados == NOS_POR_BLOCO) {
+        BlocoNos *bloco = h->reserva;
+        if(bloco != NULL) {
+            h->reserva = bloco->proximo;
+        } else {
+            bloco = malloc(sizeof(BlocoNos));
+            if(bloco == NULL) {
+                h->semMemoria = true;
+                return NULL;
+            }
+        }
+        bloco->proximo = h->blocos;
+        bloco->usados = 0;
+        h->blocos = bloco;
+    }
+    h->nosAlocados++;
+    return &h->blocos->nos[h->blocos->usados++];
+}
+
+/**
+ * Libera uma lista de blocos inteira
+ */
+static void liberarBlocos(BlocoNos *bloco) {
+    while(bloco != NULL) {
+        BlocoNos *proximo = bloco->proximo;
+        free(bloco);
+        bloco = proximo;
+    }
+}
+
+static int tamanhoNo(const NoVersao *no) {
+    return no != NULL ? no->tamanho : 0;
+}
+
+static void recalcularTamanho(NoVersao *no) {
+    no->tamanho = 1 + tamanhoNo(no->esquerda) + tamanhoNo(no->direita);
+}
+
+/**
+ * Copia um nó publicado para poder alterá-lo (cópia de caminho)
+ */
+static NoVersao *copiarNo(HistoricoMochila *h, const NoVersao *original) {
+    NoVersao *copia = novoNo(h);
+    if(copia != NULL) {
+        *copia = *original;
+    }
+    return copia;
+}
+
+/**
+ * Sorteia o peso de um nó novo (xorshift32)
+ */
+static unsigned int sortearPeso(HistoricoMochila *h) {
+    h->semente ^= h->semente << 13;
+    h->semente ^= h->semente >> 17;
+    h->semente ^= h->semente << 5;
+    return h->semente;
+}
+
+/**
+ * Divide a árvore em [0, k) e [k, n), copiando só o caminho percorrido
+ */
+static void dividir(HistoricoMochila *h, const NoVersao *t, int k,
+                    NoVersao **antes, NoVersao **depois) {
+    if(t == NULL) {
+        *antes = NULL;
+        *depois = NULL;
+        return;
+    }
+    
+    NoVersao *copia = copiarNo(h, t);
+    if(copia == NULL) {
+        *antes = NULL;
+        *depois = NULL;
+        return;
+    }
+    
+    if(tamanhoNo(t->esquerda) < k) {
+        dividir(h, t->direita, k - tamanhoNo(t->esquerda) - 1, &copia->direita, depois);
+        *antes = copia;
+    } else {
+        dividir(h, t->esquerda, k, antes, &copia->esquerda);
+        *depois = copia;
+    }
+    recalcularTamanho(copia);
+}
+
+/**
+ * Une duas árvores (todas as posições de 'a' antes das de 'b')
+ */
+static NoVersao *unir(HistoricoMochila *h, NoVersao *a, NoVersao *b) {
+    if(a == NULL) {
+        return b;
+    }
+    if(b == NULL) {
+        return a;
+    }
+    
+    NoVersao *copia;
+    if(a->peso > b->peso) {
+        copia = copiarNo(h, a);
+        if(copia == NULL) {
+            return NULL;
+        }
+        copia->direita = unir(h, a->direita, b);
+    } else {
+        copia = copiarNo(h, b);
+        if(copia == NULL) {
+            return NULL;
+        }
+        copia->esquerda = unir(h, a, b->esquerda);
+    }
+    recalcularTamanho(copia);
+    return copia;
+}
+
+/**
+ * Nova versão com o item inserido na posição, O(log n) nós novos
+ */
+static NoVersao *inserirNo(HistoricoMochila *h, const NoVersao *raiz, int posicao, const Item *item) {
+    NoVersao *antes;
+    NoVersao *depois;
+    NoVersao *no = novoNo(h);
+    
+    if(no == NULL) {
+        return NULL;
+    }
+    no->item = *item;
+    no->esquerda = NULL;
+    no->direita = NULL;
+    no->tamanho = 1;
+    no->peso = sortearPeso(h);
+    
+    dividir(h, raiz, posicao, &antes, &depois);
+    return unir(h, unir(h, antes, no), depois);
+}
+
+/**
+ * Nova versão sem o item da posição, O(log n) nós novos
+ */
+static NoVersao *removerNo(HistoricoMochila *h, const NoVersao *raiz, int posicao) {
+    NoVersao *antes;
+    NoVersao *resto;
+    NoVersao *removido;
+    NoVersao *depois;
+    
+    dividir(h, raiz, posicao, &antes, &resto);
+    dividir(h, resto, 1, &removido, &depois);
+    return unir(h, antes, depois);
+}
+
+/**
+ * Nova versão com o item da posição substituído, O(log n) nós novos
+ */
+static NoVersao *alterarNo(HistoricoMochila *h, const NoVersao *t, int posicao, const Item *item) {
+    NoVersao *copia = copiarNo(h, t);
+    if(copia == NULL) {
+        return NULL;
+    }
+    
+    int esquerda = tamanhoNo(t->esquerda);
+    if(posicao < esquerda) {
+        copia->esquerda = alterarNo(h, t->esquerda, posicao, item);
+    } else if(posicao > esquerda) {
+        copia->direita = alterarNo(h, t->direita, posicao - esquerda - 1, item);
+    } else {
+        copia->item = *item;
+    }
+    return copia;
+}
+
+/**
+ * Item da posição em uma versão, O(log n)
+ */
+static const Item *obterItem(const NoVersao *t, int posicao) {
+    while(t != NULL) {
+        int esquerda = tamanhoNo(t->esquerda);
+        if(posicao < esquerda) {
+            t = t->esquerda;
+        } else if(posicao > esquerda) {
+            posicao -= esquerda + 1;
+            t = t->direita;
+        } else {
+            return &t->item;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Calcula os tamanhos de uma árvore recém-construída (pós-ordem)
+ */
+static int calcularTamanhos(NoVersao *t) {
+    if(t == NULL) {
+        return 0;
+    }
+    t->tamanho = 1 + calcularTamanhos(t->esquerda) + calcularTamanhos(t->direita);
+    return t->tamanho;
+}
+
+/**
+ * Constrói uma árvore com os itens na ordem do vetor, O(n)
+ * Árvore cartesiana por pilha: cada nó novo entra na espinha direita, e os nós
+ * de peso menor que ele descem para a sua subárvore esquerda.
+ */
+static NoVersao *construirArvore(HistoricoMochila *h, const Item *itens, int n) {
+    if(n == 0) {
+        return NULL;
+    }
+    
+    NoVersao **pilha = malloc((size_t)n * sizeof(NoVersao *));
+    if(pilha == NULL) {
+        h->semMemoria = true;
+        return NULL;
+    }
+    
+    int topo = 0;
+    for(int i = 0; i < n; i++) {
+        NoVersao *no = novoNo(h);
+        if(no == NULL) {
+            free(pilha);
+            return NULL;
+        }
+        no->item = itens[i];
+        no->direita = NULL;
+        no->peso = sortearPeso(h);
+        
+        NoVersao *ultimo = NULL;
+        while(topo > 0 && pilha[topo - 1]->peso < no->peso) {
+            ultimo = pilha[--topo];
+        }
+        no->esquerda = ultimo;
+        if(topo > 0) {
+            pilha[topo - 1]->direita = no;
+        }
+        pilha[topo++] = no;
+    }
+    
+    NoVersao *raiz = pilha[0];
+    free(pilha);
+    calcularTamanhos(raiz);
+    return raiz;
+}
+
+/**
+ * Copia os itens de uma versão para o vetor, em ordem
+ * @return Próxima posição livre do vetor
+ */
+static int materializar(const NoVersao *t, Item *destino, int posicao) {
+    if(t == NULL) {
+        return posicao;
+    }
+    posicao = materializar(t->esquerda, destino, posicao);
+    destino[posicao++] = t->item;
+    return materializar(t->direita, destino, posicao);
+}
+
+/**
+ * Troca o vetor inteiro pelo conteúdo de uma versão, O(n)
+ * Agregados recalculados; índices por nome invalidados.
+ */
+static void visaoSubstituir(Mochila *m, const NoVersao *raiz) {
+    m->numItens = materializar(raiz, m->itens, 0);
+    m->totalUnidades = 0;
+    m->itensAltaPrioridade = 0;
+    for(int i = 0; i < m->numItens; i++) {
+        atualizarAgregados(m, &m->itens[i], +1);
+    }
+    invalidarHash(m);
+    invalidarEytzinger(m);
+}
+
+/**
+ * Garante espaço para mais uma versão após a atual
+ */
+static StatusMochila reservarVersao(HistoricoMochila *h) {
+    if(h->atual + 2 <= h->capacidadeVersoes) {
+        return MOCHILA_OK;
+    }
+    
+    int capacidade = h->capacidadeVersoes * 2;
+    Versao *versoes = realloc(h->versoes, (size_t)capacidade * sizeof(Versao));
+    if(versoes == NULL) {
+        return MOCHILA_SEM_MEMORIA;
+    }
+    h->versoes = versoes;
+    h->capacidadeVersoes = capacidade;
+    return MOCHILA_OK;
+}
+
+/**
+ * Primeira fase do registro: calcula a árvore da próxima versão
+ * Nada é alterado no vetor; em caso de falha a operação é abortada intacta.
+ * Com o histórico desligado, não faz nada.
+ * @param raiz Saída: árvore da nova versão
+ */
+static StatusMochila prepararVersao(Mochila *m, OperacaoVersao operacao, int posicao,
+                                    const Item *item, NoVersao **raiz) {
+    HistoricoMochila *h = m->historico;
+    
+    *raiz = NULL;
+    if(h == NULL) {
+        return MOCHILA_OK;
+    }
+    if(reservarVersao(h) != MOCHILA_OK) {
+        return MOCHILA_SEM_MEMORIA;
+    }
+    
+    NoVersao *anterior = h->versoes[h->atual].raiz;
+    h->semMemoria = false;
+    
+    switch(operacao) {
+        case VERSAO_INSERIR:
+            *raiz = inserirNo(h, anterior, posicao, item);
+            break;
+        case VERSAO_REMOVER:
+            *raiz = removerNo(h, anterior, posicao);
+            break;
+        case VERSAO_ALTERAR:
+            *raiz = alterarNo(h, anterior, posicao, item);
+            break;
+        case VERSAO_MARCAR:
+            *raiz = anterior;   // Mesmo conteúdo: a árvore é compartilhada inteira
+            break;
+        default:
+            // SUBSTITUIR: o vetor já está na nova ordem
+            *raiz = construirArvore(h, m->itens, m->numItens);
+            break;
+    }
+    
+    return h->semMemoria ? MOCHILA_SEM_MEMORIA : MOCHILA_OK;
+}
+
+/**
+ * Copia um nó vivo (e seus descendentes) para a arena nova
+ * O nó antigo vira um endereço de encaminhamento (tamanho = -1, esquerda = cópia),
+ * então subárvores compartilhadas entre versões continuam compartilhadas.
+ * Os blocos vêm da reserva, logo novoNo não falha aqui.
+ */
+static NoVersao *copiarVivo(HistoricoMochila *h, NoVersao *no) {
+    if(no == NULL) {
+        return NULL;
+    }
+    if(no->tamanho < 0) {
+        return no->esquerda;    // Já copiado por outra versão
+    }
+    
+    NoVersao *copia = novoNo(h);
+    *copia = *no;
+    no->tamanho = -1;
+    no->esquerda = copia;
+    copia->esquerda = copiarVivo(h, copia->esquerda);
+    copia->direita = copiarVivo(h, copia->direita);
+    return copia;
+}
+
+/**
+ * Devolve os nós que nenhuma versão ou snapshot alcança (coleta por cópia)
+ * Custo O(nós vivos); disparada só quando a arena passa do dobro dos vivos,
+ * o que dilui o custo entre as operações. Sem memória para a cópia, nada muda.
+ */
+static void compactarHistorico(HistoricoMochila *h) {
+    size_t blocos = (h->nosAlocados + NOS_POR_BLOCO - 1) / NOS_POR_BLOCO;
+    BlocoNos *reserva = NULL;
+    
+    // Reserva o pior caso (todos vivos) antes de tocar em qualquer nó
+    for(size_t i = 0; i < blocos; i++) {
+        BlocoNos *bloco = malloc(sizeof(BlocoNos));
+        if(bloco == NULL) {
+            liberarBlocos(reserva);
+            return;
+        }
+        bloco->proximo = reserva;
+        reserva = bloco;
+    }
+    
+    BlocoNos *antigos = h->blocos;
+    h->blocos = NULL;
+    h->reserva = reserva;
+    h->nosAlocados = 0;
+    
+    for(int i = 0; i < h->numVersoes; i++) {
+        h->versoes[i].raiz = copiarVivo(h, h->versoes[i].raiz);
+    }
+    for(int i = 0; i < h->numSnapshots; i++) {
+        h->snapshots[i].raiz = copiarVivo(h, h->snapshots[i].raiz);
+    }
+    
+    liberarBlocos(antigos);
+    liberarBlocos(h->reserva);
+    h->reserva = NULL;
+    h->nosVivos = h->nosAlocados;
+}
+
+/**
+ * Segunda fase do registro: publica a versão preparada (não falha)
+ * Descarta as versões que ainda poderiam ser refeitas e, passando de
+ * MAX_VERSOES_HISTORICO, a mais antiga (a seguinte vira a versão inicial).
+ */
+static void confirmarVersao(Mochila *m, NoVersao *raiz, OperacaoVersao operacao, int posicao) {
+    HistoricoMochila *h = m->historico;
+    if(h == NULL) {
+        return;
+    }
+    
+    h->atual++;
+    h->numVersoes = h->atual + 1;
+    h->versoes[h->atual].raiz = raiz;
+    h->versoes[h->atual].operacao = operacao;
+    h->versoes[h->atual].posicao = posicao;
+    h->versoes[h->atual].ordenadaPorNome = m->ordenadaPorNome;
+    
+    if(h->atual > MAX_VERSOES_HISTORICO) {
+        memmove(&h->versoes[0], &h->versoes[1], (size_t)h->atual * sizeof(Versao));
+        h->atual--;
+        h->numVersoes--;
+        h->versoes[0].operacao = VERSAO_INICIAL;
+    }
+    
+    // Versões descartadas deixam nós inalcançáveis para trás
+    if(h->nosAlocados > 2 * h->nosVivos + 4 * NOS_POR_BLOCO) {
+        compactarHistorico(h);
+    }
+}
+
+/**
+ * Volta o vetor para a versão atual (usado quando uma ordenação não pôde ser registrada)
+ */
+static void restaurarVersaoAtual(Mochila *m) {
+    const Versao *versao = &m->historico->versoes[m->historico->atual];
+    visaoSubstituir(m, versao->raiz);
+    m->ordenadaPorNome = versao->ordenadaPorNome;
+}
+
+/**
+ * Liga o histórico: a versão 0 é o conteúdo atual (O(n) nós)
+ * Chamar com o histórico já ligado não faz nada.
+ */
+StatusMochila mochilaHabilitarHistorico(Mochila *m) {
+    if(m == NULL) {
+        return MOCHILA_ARGUMENTO_INVALIDO;
+    }
+    if(m->historico != NULL) {
+        return MOCHILA_OK;
+    }
+    
+    HistoricoMochila *h = calloc(1, sizeof(HistoricoMochila));
+    if(h == NULL) {
+        return MOCHILA_SEM_MEMORIA;
+    }
+    h->semente = 2463534242u;   // Semente fixa: execuções reproduzíveis
+    h->versoes = malloc(VERSOES_INICIAIS * sizeof(Versao));
+    h->capacidadeVersoes = VERSOES_INICIAIS;
+    m->historico = h;
+    
+    if(h->versoes == NULL) {
+        mochilaDesabilitarHistorico(m);
+        return MOCHILA_SEM_MEMORIA;
+    }
+    
+    NoVersao *raiz = construirArvore(h, m->itens, m->numItens);
+    if(h->semMemoria) {
+        mochilaDesabilitarHistorico(m);
+        return MOCHILA_SEM_MEMORIA;
+    }
+    
+    h->versoes[0].raiz = raiz;
+    h->versoes[0].operacao = VERSAO_INICIAL;
+    h->versoes[0].posicao = 0;
+    h->versoes[0].ordenadaPorNome = m->ordenadaPorNome;
+    h->numVersoes = 1;
+    h->atual = 0;
+    h->nosVivos = h->nosAlocados;
+    return MOCHILA_OK;
+}
+
+/**
+ * Desliga o histórico liberando arena, versões e snapshots
+ */
+void mochilaDesabilitarHistorico(Mochila *m) {
+    if(m == NULL || m->historico == NULL) {
+        return;
+    }
+    
+    HistoricoMochila *h = m->historico;
+    liberarBlocos(h->blocos);
+    liberarBlocos(h->reserva);
+    free(h->versoes);
+    free(h->snapshots);
+    free(h);
+    m->historico = NULL;
+}
+
+/**
+ * Desfaz a versão atual aplicando ao vetor a operação inversa
+ * - INSERIR desfeito: remove a posição
+ * - REMOVER desfeito: reinsere o item lido da versão anterior, O(log n) + deslocamento
+ * - ALTERAR desfeito: regrava o item anterior no próprio lugar
+ * - SUBSTITUIR desfeito: copia a versão anterior inteira, O(n)
+ *   (nada a copiar se as duas versões têm a mesma árvore, como em MARCAR)
+ */
+StatusMochila mochilaDesfazer(Mochila *m) {
+    if(m == NULL) {
+        return MOCHILA_ARGUMENTO_INVALIDO;
+    }
+    HistoricoMochila *h = m->historico;
+    if(h == NULL || h->atual == 0) {
+        return MOCHILA_SEM_HISTORICO;
+    }
+    
+    const Versao *desfeita = &h->versoes[h->atual];
+    const Versao *destino = &h->versoes[h->atual - 1];
+    
+    switch(desfeita->operacao) {
+        case VERSAO_INSERIR:
+            visaoRemover(m, desfeita->posicao);
+            break;
+        case VERSAO_REMOVER:
+            visaoInserir(m, desfeita->posicao, obterItem(destino->raiz, desfeita->posicao));
+            break;
+        case VERSAO_ALTERAR:
+            visaoAlterar(m, desfeita->posicao, obterItem(destino->raiz, desfeita->posicao));
+            break;
+        default:
+            if(destino->raiz != desfeita->raiz) {
+                visaoSubstituir(m, destino->raiz);
+            }
+            break;
+    }
+    
+    m->ordenadaPorNome = destino->ordenadaPorNome;
+    h->atual--;
+    return MOCHILA_OK;
+}
+
+/**
+ * Refaz a próxima versão aplicando ao vetor a mesma operação registrada
+ */
+StatusMochila mochilaRefazer(Mochila *m) {
+    if(m == NULL) {
+        return MOCHILA_ARGUMENTO_INVALIDO;
+    }
+    HistoricoMochila *h = m->historico;
+    if(h == NULL || h->atual + 1 >= h->numVersoes) {
+        return MOCHILA_SEM_HISTORICO;
+    }
+    
+    const Versao *destino = &h->versoes[h->atual + 1];
+    
+    switch(destino->operacao) {
+        case VERSAO_INSERIR:
+            visaoInserir(m, destino->posicao, obterItem(destino->raiz, destino->posicao));
+            break;
+        case VERSAO_REMOVER:
+            visaoRemover(m, destino->posicao);
+            break;
+        case VERSAO_ALTERAR:
+            visaoAlterar(m, destino->posicao, obterItem(destino->raiz, destino->posicao));
+            break;
+        default:
+            if(destino->raiz != h->versoes[h->atual].raiz) {
+                visaoSubstituir(m, destino->raiz);
+            }
+            break;
+    }
+    
+    m->ordenadaPorNome = destino->ordenadaPorNome;
+    h->atual++;
+    return MOCHILA_OK;
+}
+
+/**
+ * Guarda a versão atual com um nome; apenas a raiz é copiada, O(1) nós
+ * Nomes que não caberiam em MAX_NOME são recusados: truncados, não poderiam
+ * ser encontrados de novo pelo nome completo.
+ */
+StatusMochila mochilaSalvarSnapshot(Mochila *m, const char *nome) {
+    if(m == NULL || nome == NULL || strlen(nome) >= MAX_NOME) {
+        return MOCHILA_ARGUMENTO_INVALIDO;
+    }
+    HistoricoMochila *h = m->historico;
+    if(h == NULL) {
+        return MOCHILA_SEM_HISTORICO;
+    }
+    
+    // Nome já usado: sobrescreve
+    Snapshot *snapshot = NULL;
+    for(int i = 0; i < h->numSnapshots; i++) {
+        if(strcmp(h->snapshots[i].nome, nome) == 0) {
+            snapshot = &h->snapshots[i];
+            break;
+        }
+    }
+    
+    if(snapshot == NULL) {
+        if(h->numSnapshots == h->capacidadeSnapshots) {
+            int capacidade = h->capacidadeSnapshots > 0 ? h->capacidadeSnapshots * 2 : 4;
+            Snapshot *snapshots = realloc(h->snapshots, (size_t)capacidade * sizeof(Snapshot));
+            if(snapshots == NULL) {
+                return MOCHILA_SEM_MEMORIA;
+            }
+            h->snapshots = snapshots;
+            h->capacidadeSnapshots = capacidade;
+        }
+        snapshot = &h->snapshots[h->numSnapshots++];
+        strncpy(snapshot->nome, nome, MAX_NOME - 1);
+        snapshot->nome[MAX_NOME - 1] = '\0';
+    }
+    
+    snapshot->raiz = h->versoes[h->atual].raiz;
+    snapshot->ordenadaPorNome = h->versoes[h->atual].ordenadaPorNome;
+    return MOCHILA_OK;
+}
+
+/**
+ * Restaura um snapshot como nova versão (a árvore é reaproveitada, sem nós novos)
+ * O vetor é recopiado em O(n), pois o salto pode ser arbitrário.
+ */
+StatusMochila mochilaRestaurarSnapshot(Mochila *m, const char *nome) {
+    if(m == NULL || nome == NULL || strlen(nome) >= MAX_NOME) {
+        return MOCHILA_ARGUMENTO_INVALIDO;
+    }
+    HistoricoMochila *h = m->historico;
+    if(h == NULL) {
+        return MOCHILA_SEM_HISTORICO;
+    }
+    
+    for(int i = 0; i < h->numSnapshots; i++) {
+        if(strcmp(h->snapshots[i].nome, nome) == 0) {
+            if(reservarVersao(h) != MOCHILA_OK) {
+                return MOCHILA_SEM_MEMORIA;
+            }
+            visaoSubstituir(m, h->snapshots[i].raiz);
+            m->ordenadaPorNome = h->snapshots[i].ordenadaPorNome;
+            confirmarVersao(m, h->snapshots[i].raiz, VERSAO_SUBSTITUIR, 0);
+            return MOCHILA_OK;
+        }
+    }
+    return MOCHILA_NAO_ENCONTRADO;
+}
@@ -0,0 +1,298 @@
+/*
+ * =====================================================================================
+ * BIBLIOTECA: Mochila - Nucleo do Codigo da Ilha
+ * DESCRICAO: Operacoes da mochila (insercao, remocao, buscas e ordenacao) sem
+ *            nenhuma entrada/saida de console. Todas as funcoes recebem o
+ *            contexto (Mochila *) e devolvem um StatusMochila.
+ * USO: Incluir este cabecalho e ligar com libmochila.a (ver Makefile)
+ * =====================================================================================
+ */
+
+#ifndef MOCHILA_H
+#define MOCHILA_H
+
+#include <stdbool.h>    // Tipo booleano (true/false)
+#include <stdint.h>     // Inteiros de largura fixa (uint64_t)
+
+/*
+ * =====================================================================================
+ * CONSTANTES DA BIBLIOTECA
+ * =====================================================================================
+ */
+#define MAX_NOME 50     // Tamanho maximo do nome do item
+#define MAX_TIPO 30     // Tamanho maximo do tipo do item
+#define LIMIAR_BUSCA_LINEAR 16  // Ate este tamanho a busca linear e a mais barata
+#define BUSCAS_ANTES_DO_INDICE 4    // Buscas sem indice seguidas antes de reconstruir hash/Eytzinger
+#define MAX_VERSOES_HISTORICO 64    // Operacoes que podem ser desfeitas em sequencia
+
+/*
+ * =====================================================================================
+ * ESTRUTURAS DE DADOS
+ * =====================================================================================
+ */
+
+/**
+ * Estrutura Item: Representa um componente coletado na ilha
+ * @nome: Nome identificador do item (ex: "AK-47", "Kit Medico")
+ * @tipo: Categoria do item (ex: "Arma", "Medicamento", "Equipamento")
+ * @quantidade: Numero de unidades do item na mochila
+ * @prioridade: Nivel de importancia (1=Muito Baixa, 2=Baixa, 3=Media, 4=Alta, 5=Muito Alta)
+ */
+typedef struct {
+    char nome[MAX_NOME];        // Nome do item
+    char tipo[MAX_TIPO];        // Tipo/categoria do item
+    int quantidade;             // Quantidade disponivel
+    int prioridade;             // Prioridade de uso (1-5)
+} Item;
+
+/**
+ * Enumeracao CriterioOrdenacao: Define os criterios disponiveis para ordenacao
+ * NOME: Ordenacao alfabetica por nome (A-Z)
+ * TIPO: Ordenacao alfabetica por tipo (A-Z)
+ * PRIORIDADE: Ordenacao por prioridade (Alta para Baixa)
+ */
+typedef enum {
+    NOME = 1,           // Criterio: ordenar por nome
+    TIPO,               // Criterio: ordenar por tipo
+    PRIORIDADE          // Criterio: ordenar por prioridade
+} CriterioOrdenacao;
+
+/**
+ * Enumeracao EstrategiaBusca: Algoritmo escolhido pelo despachante mochilaBuscar
+ * BUSCA_LINEAR: Varredura sequencial (poucos itens)
+ * BUSCA_BINARIA: Divisao ao meio (mochila ordenada por nome)
+ * BUSCA_HASH: Indice de espalhamento por nome (muitos itens sem ordenacao)
+ * BUSCA_EYTZINGER: Descida sem desvios no layout Eytzinger (ordenada, layout ativo)
+ */
+typedef enum {
+    BUSCA_LINEAR = 1,   // Estrategia: busca sequencial
+    BUSCA_BINARIA,      // Estrategia: busca binaria
+    BUSCA_HASH,         // Estrategia: tabela hash
+    BUSCA_EYTZINGER     // Estrategia: layout Eytzinger de prefixos
+} EstrategiaBusca;
+
+/**
+ * Enumeracao StatusMochila: Codigos de retorno de todas as operacoes
+ * Zero indica sucesso; qualquer outro valor descreve o motivo da falha.
+ */
+typedef enum {
+    MOCHILA_OK = 0,                 // Operacao concluida
+    MOCHILA_CHEIA,                  // Capacidade maxima atingida
+    MOCHILA_VAZIA,                  // Nao ha itens para a operacao
+    MOCHILA_NAO_ENCONTRADO,         // Nenhum item com o nome informado
+    MOCHILA_NAO_ORDENADA,           // Busca binaria exige ordenacao por nome
+    MOCHILA_PRIORIDADE_INVALIDA,    // Prioridade fora do intervalo 1-5
+    MOCHILA_QUANTIDADE_INVALIDA,    // Quantidade resultante negativa ou acima de INT_MAX
+    MOCHILA_ARGUMENTO_INVALIDO,     // Ponteiro nulo, indice ou criterio invalido
+    MOCHILA_SEM_MEMORIA,            // Falha de alocacao
+    MOCHILA_SEM_HISTORICO           // Historico desligado ou nada a desfazer/refazer
+} StatusMochila;
+
+/**
+ * Estrutura opaca HistoricoMochila: versoes persistentes (ver mochilaHabilitarHistorico)
+ */
+typedef struct HistoricoMochila HistoricoMochila;
+
+/**
+ * Estrutura Mochila: Contexto com todo o estado de uma mochila
+ * Os campos podem ser lidos livremente, mas so a biblioteca os altera: flags e
+ * indices carregam invariantes (e o historico guarda ordenadaPorNome por versao).
+ * Os modos configuraveis mudam por mochilaDefinirMesclagem/mochilaDefinirLayoutEytzinger.
+ * @itens: Vetor alocado com 'capacidade' posicoes
+ * @numItens: Quantidade de posicoes ocupadas
+ * @capacidade: Limite de itens distintos
+ * @ordenadaPorNome: Indica se a busca binaria pode ser usada
+ * @mesclarDuplicados: Nome repetido soma quantidade em vez de duplicar
+ * @totalUnidades: Agregado - soma das quantidades
+ * @itensAltaPrioridade: Agregado - itens com prioridade 4-5
+ * @indiceHash: Tabela hash (enderecamento aberto) nome -> posicao, criada sob demanda
+ * @tamanhoHash: Numero de posicoes da tabela (potencia de 2, >= 2 * numItens)
+ * @hashValido: false apos remocao/ordenacao; a tabela e reconstruida sob demanda
+ * @buscasSemHash: Buscas lineares feitas desde que a tabela foi invalidada
+ * @layoutEytzinger: Mantem a visao ordenada por nome tambem em layout Eytzinger
+ * @eytzChave: Prefixos de 8 bytes dos nomes em ordem BFS (posicoes 1..numItens),
+ *             alinhado a 64 bytes (liberado pela biblioteca, nunca com free)
+ * @eytzPosicao: Posicao no vetor ordenado correspondente a cada prefixo
+ * @eytzValido: false apos insercao/remocao; reconstruido na ordenacao ou apos
+ *             BUSCAS_ANTES_DO_INDICE buscas binarias
+ * @buscasSemEytzinger: Buscas binarias feitas desde que o layout foi invalidado
+ * @historico: Versoes para desfazer/refazer e snapshots (NULL = desligado)
+ */
+typedef struct {
+    Item *itens;                // Vetor de itens
+    int numItens;               // Itens ocupados
+    int capacidade;             // Capacidade maxima
+    bool ordenadaPorNome;       // Flag de ordenacao por nome
+    bool mesclarDuplicados;     // Modo de insercao de nomes repetidos
+    int totalUnidades;          // Soma das quantidades (mantida a cada operacao)
+    int itensAltaPrioridade;    // Itens com prioridade 4-5 (mantido a cada operacao)
+    int *indiceHash;            // Posicoes dos itens por hash do nome (-1 = vazio)
+    int tamanhoHash;            // Tamanho da tabela hash
+    bool hashValido;            // Tabela reflete o vetor atual
+    int buscasSemHash;          // Buscas desde a invalidacao (ver BUSCAS_ANTES_DO_INDICE)
+    bool layoutEytzinger;       // Usa o layout Eytzinger quando ordenada por nome
+    uint64_t *eytzChave;        // Prefixos dos nomes em ordem BFS (base 1)
+    int *eytzPosicao;           // Prefixo -> posicao no vetor ordenado
+    bool eytzValido;            // Layout reflete o vetor atual
+    int buscasSemEytzinger;     // Buscas desde a invalidacao (ver BUSCAS_ANTES_DO_INDICE)
+    HistoricoMochila *historico;    // Versionamento persistente (opcional)
+} Mochila;
+
+/*
+ * =====================================================================================
+ * CICLO DE VIDA
+ * =====================================================================================
+ */
+StatusMochila mochilaInicializar(Mochila *m, int capacidade);  // Aloca e zera o contexto
+void mochilaLiberar(Mochila *m);                                // Libera a memoria do contexto
+
+/*
+ * =====================================================================================
+ * CONFIGURACAO
+ * =====================================================================================
+ */
+
+/**
+ * Liga/desliga a mesclagem de nomes repetidos na insercao (padrao: ligada)
+ */
+StatusMochila mochilaDefinirMesclagem(Mochila *m, bool ativa);
+
+/**
+ * Liga/desliga o layout Eytzinger da visao ordenada por nome (padrao: desligado)
+ * Ao ligar, o layout e construido na proxima busca; ao desligar, sua memoria e liberada.
+ */
+StatusMochila mochilaDefinirLayoutEytzinger(Mochila *m, bool ativo);
+
+/*
+ * =====================================================================================
+ * OPERACOES
+ * =====================================================================================
+ */
+
+/**
+ * Insere um item (ou soma sua quantidade ao existente, com mesclagem ativa)
+ * @param indice Saida opcional: posicao do item inserido/mesclado
+ * @param mesclado Saida opcional: true se o nome ja existia e foi mesclado
+ */
+StatusMochila mochilaInserir(Mochila *m, const Item *item, int *indice, bool *mesclado);
+
+/**
+ * Remove o item com o nome informado, preservando a ordem dos demais
+ * @param removido Saida opcional: copia do item removido
+ */
+StatusMochila mochilaRemover(Mochila *m, const char *nome, Item *removido);
+
+/**
+ * Soma 'delta' a quantidade do item na posicao 'indice', no proprio lugar
+ * A ordenacao vigente e mantida (quantidade nao e criterio de ordenacao).
+ * Delta zero nao altera nada nem gera versao no historico.
+ */
+StatusMochila mochilaAjustarQuantidade(Mochila *m, int indice, int delta);
+
+/**
+ * Ordena a mochila por Insertion Sort segundo o criterio
+ * @param comparacoes Saida opcional: comparacoes realizadas
+ */
+StatusMochila mochilaOrdenar(Mochila *m, CriterioOrdenacao criterio, int *comparacoes);
+
+/*
+ * =====================================================================================
+ * BUSCAS (as que recebem Mochila * nao constante alteram o contexto: mochilaBuscar e
+ * mochilaLocalizar mantem o indice hash; mochilaBuscarEytzinger reconstroi o layout)
+ * =====================================================================================
+ */
+
+/**
+ * Busca sequencial pelo nome (primeira ocorrencia)
+ * @param indice Saida: posicao do item encontrado
+ * @param passos Saida opcional: comparacoes realizadas
+ */
+StatusMochila mochilaBuscarSequencial(const Mochila *m, const char *nome, int *indice, int *passos);
+
+/**
+ * Busca binaria pelo nome; devolve MOCHILA_NAO_ORDENADA se o pre-requisito falhar
+ * @param indice Saida: posicao do item encontrado
+ * @param passos Saida opcional: comparacoes realizadas
+ */
+StatusMochila mochilaBuscarBinaria(const Mochila *m, const char *nome, int *indice, int *passos);
+
+/**
+ * Busca no layout Eytzinger: descida sem desvios sobre prefixos de 8 bytes com
+ * prefetch, seguida de strcmp apenas nos nomes com o mesmo prefixo.
+ * Devolve MOCHILA_NAO_ORDENADA se a mochila nao estiver ordenada por nome.
+ * @param indice Saida: posicao do item encontrado
+ * @param passos Saida opcional: niveis descidos + comparacoes de nome
+ */
+StatusMochila mochilaBuscarEytzinger(Mochila *m, const char *nome, int *indice, int *passos);
+
+/**
+ * Despachante de busca: escolhe a estrategia mais barata para o estado atual
+ * - numItens <= LIMIAR_BUSCA_LINEAR: linear
+ * - ordenada por nome: Eytzinger se layoutEytzinger, senao binaria; com o layout
+ *   invalidado, as primeiras BUSCAS_ANTES_DO_INDICE buscas sao binarias e so a
+ *   seguinte o reconstroi, em O(n)
+ * - demais casos: hash; com a tabela invalidada, as primeiras BUSCAS_ANTES_DO_INDICE
+ *   buscas sao lineares e so a seguinte reconstroi a tabela, em O(n)
+ * Sem memoria para um indice, a busca recai na binaria/linear em vez de falhar.
+ * @param estrategia Saida opcional: estrategia escolhida
+ * @param passos Saida opcional: comparacoes de nome, ou sondagens da tabela
+ *        (mais numItens quando a busca reconstruiu a tabela)
+ */
+StatusMochila mochilaBuscar(Mochila *m, const char *nome, int *indice,
+                            EstrategiaBusca *estrategia, int *passos);
+
+/**
+ * Localiza o item pelo nome via mochilaBuscar, sem relatorio de custo
+ */
+StatusMochila mochilaLocalizar(Mochila *m, const char *nome, int *indice);
+
+/*
+ * =====================================================================================
+ * HISTORICO (VERSOES PERSISTENTES)
+ * Cada versao e uma arvore persistente que compartilha com a anterior tudo o que
+ * nao mudou: insercao, remocao e ajuste de quantidade gravam O(log n) nos;
+ * ordenar grava O(n) (todas as posicoes mudam; uma ordenacao que nao move nada
+ * nao grava nos). Desfazer/refazer aplicam ao vetor apenas a diferenca entre
+ * as versoes vizinhas. Guardam-se no maximo MAX_VERSOES_HISTORICO operacoes
+ * (as mais antigas sao descartadas), e os nos que nenhuma versao ou snapshot
+ * alcanca mais sao devolvidos por compactacao periodica da memoria.
+ * =====================================================================================
+ */
+
+/**
+ * Liga o historico; a versao inicial e o conteudo atual da mochila, O(n)
+ */
+StatusMochila mochilaHabilitarHistorico(Mochila *m);
+
+/**
+ * Desliga o historico e libera todas as versoes e snapshots
+ */
+void mochilaDesabilitarHistorico(Mochila *m);
+
+/**
+ * Volta para a versao anterior (insercao, remocao, ajuste, ordenacao ou restauracao)
+ * @return MOCHILA_SEM_HISTORICO se nao houver o que desfazer
+ */
+StatusMochila mochilaDesfazer(Mochila *m);
+
+/**
+ * Reaplica a versao desfeita mais recente; qualquer nova operacao descarta o refazer
+ * @return MOCHILA_SEM_HISTORICO se nao houver o que refazer
+ */
+StatusMochila mochilaRefazer(Mochila *m);
+
+/**
+ * Guarda a versao atual com um nome, em O(1) (a arvore e compartilhada)
+ * Um nome ja existente e sobrescrito.
+ * @return MOCHILA_ARGUMENTO_INVALIDO se o nome tiver MAX_NOME caracteres ou mais
+ */
+StatusMochila mochilaSalvarSnapshot(Mochila *m, const char *nome);
+
+/**
+ * Restaura um snapshot; a restauracao vira uma nova versao (pode ser desfeita)
+ * @return MOCHILA_NAO_ENCONTRADO se nao houver snapshot com esse nome,
+ *         MOCHILA_ARGUMENTO_INVALIDO se o nome tiver MAX_NOME caracteres ou mais
+ */
+StatusMochila mochilaRestaurarSnapshot(Mochila *m, const char *nome);
+
+#endif // MOCHILA_H
@@ -0,0 +1,455 @@
+/*
+ * =====================================================================================
+ * PROGRAMA: Testes Automatizados da Biblioteca da Mochila - Codigo da Ilha
+ * DESCRICAO: Confere a biblioteca contra modelos simples:
+ *            - operacoes basicas e validacoes (capacidade, quantidade, prioridade)
+ *            - buscas binaria, Eytzinger, hash e despachante contra a busca linear
+ *              (nomes repetidos e nomes com o mesmo prefixo de 8 bytes)
+ *            - desfazer/refazer/snapshots contra um vetor de estados guardados
+ * USO: make test
+ * =====================================================================================
+ */
+
+#include <stdio.h>      // Funcoes de entrada/saida (printf, sprintf)
+#include <stdlib.h>     // Numeros aleatorios (rand, srand)
+#include <string.h>     // Funcoes de manipulacao de strings (strcmp, memcmp)
+#include <limits.h>     // Limites dos tipos inteiros (INT_MAX)
+
+#include "mochila.h"    // Biblioteca da mochila
+
+/*
+ * =====================================================================================
+ * CONSTANTES E VERIFICACAO
+ * =====================================================================================
+ */
+#define MAX_MODELO 64           // Capacidade da mochila nos testes de historico
+#define PASSOS_HISTORICO 20000  // Operacoes aleatorias do teste de historico
+
+static int falhas = 0;          // Verificacoes que falharam
+
+/**
+ * Registra uma falha sem interromper os demais testes
+ */
+#define VERIFICAR(condicao) \
+    do { \
+        if(!(condicao)) { \
+            printf("FALHA %s:%d: %s\n", __FILE__, __LINE__, #condicao); \
+            falhas++; \
+        } \
+    } while(0)
+
+/**
+ * Monta um item com os campos informados
+ */
+static Item novoItem(const char *nome, int quantidade, int prioridade) {
+    Item item = {0};
+    snprintf(item.nome, MAX_NOME, "%s", nome);
+    strcpy(item.tipo, "Teste");
+    item.quantidade = quantidade;
+    item.prioridade = prioridade;
+    return item;
+}
+
+/*
+ * =====================================================================================
+ * OPERACOES BASICAS
+ * =====================================================================================
+ */
+
+/**
+ * Inserção, capacidade, validações, mesclagem, ordenação e buscas clássicas
+ */
+static void testarOperacoesBasicas(void) {
+    Mochila m;
+    Item item;
+    int indice;
+    bool mesclado;
+    
+    VERIFICAR(mochilaInicializar(&m, 3) == MOCHILA_OK);
+    
+    item = novoItem("Kit Medico", 2, 5);
+    VERIFICAR(mochilaInserir(&m, &item, NULL, NULL) == MOCHILA_OK);
+    item = novoItem("AK-47", 1, 4);
+    VERIFICAR(mochilaInserir(&m, &item, NULL, NULL) == MOCHILA_OK);
+    item = novoItem("Bandagem", 5, 2);
+    VERIFICAR(mochilaInserir(&m, &item, NULL, NULL) == MOCHILA_OK);
+    VERIFICAR(m.totalUnidades == 8 && m.itensAltaPrioridade == 2);
+    
+    // Capacidade: nome novo recusado, nome repetido ainda é mesclado
+    item = novoItem("Granada", 1, 3);
+    VERIFICAR(mochilaInserir(&m, &item, NULL, NULL) == MOCHILA_CHEIA);
+    item = novoItem("AK-47", 3, 4);
+    VERIFICAR(mochilaInserir(&m, &item, &indice, &mesclado) == MOCHILA_OK);
+    VERIFICAR(mesclado && indice == 1 && m.itens[1].quantidade == 4);
+    
+    // Validações valem também para a mesclagem
+    item = novoItem("AK-47", -3, 4);
+    VERIFICAR(mochilaInserir(&m, &item, NULL, NULL) == MOCHILA_QUANTIDADE_INVALIDA);
+    item = novoItem("AK-47", 1, 99);
+    VERIFICAR(mochilaInserir(&m, &item, NULL, NULL) == MOCHILA_PRIORIDADE_INVALIDA);
+    VERIFICAR(m.itens[1].quantidade == 4);
+    
+    // Ajuste de quantidade: nunca negativa, nunca acima de INT_MAX
+    VERIFICAR(mochilaAjustarQuantidade(&m, 2, -6) == MOCHILA_QUANTIDADE_INVALIDA);
+    VERIFICAR(mochilaAjustarQuantidade(&m, 2, INT_MAX) == MOCHILA_QUANTIDADE_INVALIDA);
+    VERIFICAR(mochilaAjustarQuantidade(&m, 2, -5) == MOCHILA_OK && m.itens[2].quantidade == 0);
+    VERIFICAR(m.totalUnidades == 6);
+    
+    // Buscas clássicas
+    VERIFICAR(mochilaBuscarSequencial(&m, "Bandagem", &indice, NULL) == MOCHILA_OK && indice == 2);
+    VERIFICAR(mochilaBuscarSequencial(&m, "bandagem", &indice, NULL) == MOCHILA_NAO_ENCONTRADO);
+    VERIFICAR(mochilaBuscarBinaria(&m, "Bandagem", &indice, NULL) == MOCHILA_NAO_ORDENADA);
+    
+    VERIFICAR(mochilaOrdenar(&m, NOME, NULL) == MOCHILA_OK && m.ordenadaPorNome);
+    VERIFICAR(strcmp(m.itens[0].nome, "AK-47") == 0 && strcmp(m.itens[2].nome, "Kit Medico") == 0);
+    VERIFICAR(mochilaBuscarBinaria(&m, "Bandagem", &indice, NULL) == MOCHILA_OK && indice == 1);
+    VERIFICAR(mochilaBuscarBinaria(&m, "Granada", &indice, NULL) == MOCHILA_NAO_ENCONTRADO);
+    
+    VERIFICAR(mochilaOrdenar(&m, PRIORIDADE, NULL) == MOCHILA_OK && !m.ordenadaPorNome);
+    VERIFICAR(m.itens[0].prioridade == 5 && m.itens[2].prioridade == 2);
+    
+    VERIFICAR(mochilaRemover(&m, "Granada", NULL) == MOCHILA_NAO_ENCONTRADO);
+    VERIFICAR(mochilaRemover(&m, "AK-47", &item) == MOCHILA_OK && item.quantidade == 4);
+    VERIFICAR(m.numItens == 2 && m.totalUnidades == 2 && m.itensAltaPrioridade == 1);
+    
+    mochilaLiberar(&m);
+}
+
+/*
+ * =====================================================================================
+ * BUSCAS CONTRA A BUSCA LINEAR
+ * =====================================================================================
+ */
+
+/**
+ * Gera nomes difíceis para os índices: poucos sufixos (muitas repetições) e,
+ * em metade dos casos, um prefixo comum de 8 bytes ou mais
+ */
+static void gerarNomeTeste(char *destino) {
+    static const char *prefixos[] = {"", "a", "prefixo_", "prefixo_comum_", "zz"};
+    sprintf(destino, "%s%d", prefixos[rand() % 5], rand() % 40);
+}
+
+/**
+ * Primeira ocorrência do nome por varredura (referência dos demais algoritmos)
+ */
+static int primeiraOcorrencia(const Mochila *m, const char *nome) {
+    for(int i = 0; i < m->numItens; i++) {
+        if(strcmp(m->itens[i].nome, nome) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Confere uma consulta em todas as estratégias
+ * Binária pode devolver qualquer ocorrência; Eytzinger e hash devolvem a primeira.
+ */
+static void conferirConsulta(Mochila *ordenada, Mochila *desordenada, const char *nome) {
+    int esperado = primeiraOcorrencia(ordenada, nome);
+    int indice = -1;
+    StatusMochila status;
+    
+    status = mochilaBuscarBinaria(ordenada, nome, &indice, NULL);
+    VERIFICAR((status == MOCHILA_OK) == (esperado >= 0));
+    if(status == MOCHILA_OK) {
+        VERIFICAR(strcmp(ordenada->itens[indice].nome, nome) == 0);
+    }
+    
+    status = mochilaBuscarEytzinger(ordenada, nome, &indice, NULL);
+    VERIFICAR((status == MOCHILA_OK) == (esperado >= 0));
+    VERIFICAR(status != MOCHILA_OK || indice == esperado);
+    
+    status = mochilaBuscar(ordenada, nome, &indice, NULL, NULL);
+    VERIFICAR((status == MOCHILA_OK) == (esperado >= 0));
+    
+    esperado = primeiraOcorrencia(desordenada, nome);
+    status = mochilaBuscar(desordenada, nome, &indice, NULL, NULL);
+    VERIFICAR((status == MOCHILA_OK) == (esperado >= 0));
+    VERIFICAR(status != MOCHILA_OK || indice == esperado);
+}
+
+/**
+ * Mochilas de vários tamanhos com nomes repetidos: a mesma sequência de itens
+ * numa mochila ordenada (binária/Eytzinger) e noutra desordenada (hash)
+ */
+static void testarBuscas(void) {
+    static const int tamanhos[] = {0, 1, 2, 7, 16, 17, 33, 100, 300};
+    char nome[MAX_NOME];
+    
+    for(size_t t = 0; t < sizeof(tamanhos) / sizeof(tamanhos[0]); t++) {
+        int n = tamanhos[t];
+        Mochila ordenada;
+        Mochila desordenada;
+        
+        mochilaInicializar(&ordenada, n > 0 ? n : 1);
+        mochilaInicializar(&desordenada, n > 0 ? n : 1);
+        mochilaDefinirMesclagem(&ordenada, false);      // Mantém os nomes repetidos
+        mochilaDefinirMesclagem(&desordenada, false);
+        mochilaDefinirLayoutEytzinger(&ordenada, true);
+        
+        for(int i = 0; i < n; i++) {
+            gerarNomeTeste(nome);
+            Item item = novoItem(nome, i, 1 + i % 5);
+            mochilaInserir(&ordenada, &item, NULL, NULL);
+            mochilaInserir(&desordenada, &item, NULL, NULL);
+        }
+        VERIFICAR(mochilaOrdenar(&ordenada, NOME, NULL) == MOCHILA_OK);
+        
+        // Todos os nomes presentes e alguns ausentes (inclusive prefixos de presentes)
+        for(int i = 0; i < n; i++) {
+            conferirConsulta(&ordenada, &desordenada, ordenada.itens[i].nome);
+        }
+        for(int q = 0; q < 200; q++) {
+            gerarNomeTeste(nome);
+            conferirConsulta(&ordenada, &desordenada, nome);
+        }
+        conferirConsulta(&ordenada, &desordenada, "");
+        conferirConsulta(&ordenada, &desordenada, "prefixo");
+        conferirConsulta(&ordenada, &desordenada, "prefixo_comum_");
+        
+        // Remoções invalidam os índices; as buscas seguintes continuam corretas
+        for(int r = 0; r < n / 3; r++) {
+            strcpy(nome, ordenada.itens[rand() % ordenada.numItens].nome);
+            VERIFICAR(mochilaRemover(&ordenada, nome, NULL) == MOCHILA_OK);
+            VERIFICAR(mochilaRemover(&desordenada, nome, NULL) == MOCHILA_OK);
+            conferirConsulta(&ordenada, &desordenada, nome);
+        }
+        
+        mochilaLiberar(&ordenada);
+        mochilaLiberar(&desordenada);
+    }
+    
+    // Layout desatualizado: binária nas BUSCAS_ANTES_DO_INDICE buscas seguintes,
+    // só então o despachante reconstrói o layout Eytzinger
+    Mochila m;
+    EstrategiaBusca estrategia;
+    int indice;
+    mochilaInicializar(&m, 64);
+    mochilaDefinirLayoutEytzinger(&m, true);
+    for(int i = 0; i < 40; i++) {
+        gerarNomeTeste(nome);
+        Item item = novoItem(nome, 1, 1);
+        mochilaInserir(&m, &item, NULL, NULL);
+    }
+    mochilaOrdenar(&m, NOME, NULL);
+    strcpy(nome, m.itens[0].nome);
+    VERIFICAR(mochilaRemover(&m, nome, NULL) == MOCHILA_OK);
+    for(int b = 0; b < BUSCAS_ANTES_DO_INDICE; b++) {
+        mochilaBuscar(&m, m.itens[b].nome, &indice, &estrategia, NULL);
+        VERIFICAR(estrategia == BUSCA_BINARIA && indice == b);
+    }
+    mochilaBuscar(&m, m.itens[5].nome, &indice, &estrategia, NULL);
+    VERIFICAR(estrategia == BUSCA_EYTZINGER && indice == 5);
+    mochilaLiberar(&m);
+}
+
+/*
+ * =====================================================================================
+ * HISTORICO CONTRA UM MODELO
+ * =====================================================================================
+ */
+
+/**
+ * Estrutura Estado: Cópia completa do conteúdo visível de uma versão
+ */
+typedef struct {
+    Item itens[MAX_MODELO];
+    int numItens;
+    bool ordenadaPorNome;
+} Estado;
+
+static Estado modelo[MAX_VERSOES_HISTORICO + 1];    // Versões que podem ser visitadas
+static int modeloVersoes;                           // Versões guardadas no modelo
+static int modeloAtual;                             // Versão refletida na mochila
+
+static void capturar(const Mochila *m, Estado *e) {
+    e->numItens = m->numItens;
+    e->ordenadaPorNome = m->ordenadaPorNome;
+    memcpy(e->itens, m->itens, (size_t)m->numItens * sizeof(Item));
+}
+
+static bool mesmoEstado(const Mochila *m, const Estado *e) {
+    return m->numItens == e->numItens && m->ordenadaPorNome == e->ordenadaPorNome &&
+           memcmp(m->itens, e->itens, (size_t)e->numItens * sizeof(Item)) == 0;
+}
+
+/**
+ * Nova versão no modelo: descarta o refazer e, acima do limite, a mais antiga
+ */
+static void registrarNoModelo(const Mochila *m) {
+    if(modeloAtual == MAX_VERSOES_HISTORICO) {
+        memmove(&modelo[0], &modelo[1], (size_t)modeloAtual * sizeof(Estado));
+        modeloAtual--;
+    }
+    modeloAtual++;
+    modeloVersoes = modeloAtual + 1;
+    capturar(m, &modelo[modeloAtual]);
+}
+
+/**
+ * Confere conteúdo, flag, agregados e localização de cada item
+ */
+static void conferirEstado(Mochila *m, const Estado *e) {
+    int total = 0;
+    int alta = 0;
+    
+    VERIFICAR(mesmoEstado(m, e));
+    for(int i = 0; i < e->numItens; i++) {
+        total += e->itens[i].quantidade;
+        alta += e->itens[i].prioridade >= 4;
+    }
+    VERIFICAR(m->totalUnidades == total && m->itensAltaPrioridade == alta);
+    
+    for(int i = 0; i < m->numItens; i++) {
+        int indice;
+        VERIFICAR(mochilaLocalizar(m, m->itens[i].nome, &indice) == MOCHILA_OK &&
+                  indice == primeiraOcorrencia(m, m->itens[i].nome));
+    }
+}
+
+/**
+ * Sequência aleatória de operações, desfazer, refazer e snapshots; depois de
+ * cada passo a mochila deve coincidir com a versão correspondente do modelo.
+ * O número de passos ultrapassa MAX_VERSOES_HISTORICO e força compactações.
+ */
+static void testarHistorico(void) {
+    Mochila m;
+    Estado snapshot;
+    bool temSnapshot = false;
+    int contador = 0;
+    char nome[MAX_NOME];
+    
+    mochilaInicializar(&m, MAX_MODELO);
+    mochilaDefinirMesclagem(&m, false);
+    mochilaDefinirLayoutEytzinger(&m, true);
+    
+    for(int i = 0; i < 5; i++) {
+        sprintf(nome, "inicial%d", i);
+        Item item = novoItem(nome, i, 3);
+        mochilaInserir(&m, &item, NULL, NULL);
+    }
+    VERIFICAR(mochilaDesfazer(&m) == MOCHILA_SEM_HISTORICO);
+    VERIFICAR(mochilaSalvarSnapshot(&m, "s") == MOCHILA_SEM_HISTORICO);
+    VERIFICAR(mochilaHabilitarHistorico(&m) == MOCHILA_OK);
+    capturar(&m, &modelo[0]);
+    modeloVersoes = 1;
+    modeloAtual = 0;
+    
+    for(int passo = 0; passo < PASSOS_HISTORICO && falhas == 0; passo++) {
+        StatusMochila status;
+        
+        switch(rand() % 8) {
+            case 0:
+                if(m.numItens < MAX_MODELO) {
+                    sprintf(nome, "item%d", contador++);
+                    Item item = novoItem(nome, rand() % 9, 1 + rand() % 5);
+                    VERIFICAR(mochilaInserir(&m, &item, NULL, NULL) == MOCHILA_OK);
+                    registrarNoModelo(&m);
+                }
+                break;
+            case 1:
+                if(m.numItens > 0) {
+                    strcpy(nome, m.itens[rand() % m.numItens].nome);
+                    VERIFICAR(mochilaRemover(&m, nome, NULL) == MOCHILA_OK);
+                    registrarNoModelo(&m);
+                }
+                break;
+            case 2:
+                if(m.numItens > 0) {
+                    int delta = rand() % 5;
+                    VERIFICAR(mochilaAjustarQuantidade(&m, rand() % m.numItens, delta) == MOCHILA_OK);
+                    if(delta != 0) {
+                        registrarNoModelo(&m);  // Delta zero não gera versão
+                    }
+                }
+                break;
+            case 3:
+                VERIFICAR(mochilaOrdenar(&m, (CriterioOrdenacao)(1 + rand() % 3), NULL) == MOCHILA_OK);
+                if(!mesmoEstado(&m, &modelo[modeloAtual])) {
+                    registrarNoModelo(&m);  // Ordenação sem efeito não gera versão
+                }
+                break;
+            case 4:
+                status = mochilaDesfazer(&m);
+                VERIFICAR(status == (modeloAtual > 0 ? MOCHILA_OK : MOCHILA_SEM_HISTORICO));
+                if(status == MOCHILA_OK) {
+                    modeloAtual--;
+                }
+                break;
+            case 5:
+                status = mochilaRefazer(&m);
+                VERIFICAR(status == (modeloAtual + 1 < modeloVersoes ? MOCHILA_OK : MOCHILA_SEM_HISTORICO));
+                if(status == MOCHILA_OK) {
+                    modeloAtual++;
+                }
+                break;
+            case 6:
+                VERIFICAR(mochilaSalvarSnapshot(&m, "s") == MOCHILA_OK);
+                capturar(&m, &snapshot);
+                temSnapshot = true;
+                break;
+            default:
+                status = mochilaRestaurarSnapshot(&m, "s");
+                VERIFICAR(status == (temSnapshot ? MOCHILA_OK : MOCHILA_NAO_ENCONTRADO));
+                if(status == MOCHILA_OK) {
+                    VERIFICAR(mesmoEstado(&m, &snapshot));
+                    registrarNoModelo(&m);
+                }
+                break;
+        }
+        conferirEstado(&m, &modelo[modeloAtual]);
+    }
+    
+    // Limite de profundidade: no máximo MAX_VERSOES_HISTORICO desfazer seguidos
+    int desfeitos = 0;
+    while(mochilaDesfazer(&m) == MOCHILA_OK) {
+        desfeitos++;
+    }
+    VERIFICAR(desfeitos == modeloAtual && desfeitos <= MAX_VERSOES_HISTORICO);
+    conferirEstado(&m, &modelo[0]);
+    VERIFICAR(mochilaRestaurarSnapshot(&m, "inexistente") == MOCHILA_NAO_ENCONTRADO);
+    
+    // Delta zero não gera versão: desfazer volta à alteração anterior
+    Item item = novoItem("unico", 1, 1);
+    int indice;
+    VERIFICAR(mochilaInserir(&m, &item, NULL, NULL) == MOCHILA_OK);
+    VERIFICAR(mochilaLocalizar(&m, "unico", &indice) == MOCHILA_OK);
+    VERIFICAR(mochilaAjustarQuantidade(&m, indice, 2) == MOCHILA_OK);
+    VERIFICAR(mochilaAjustarQuantidade(&m, indice, 0) == MOCHILA_OK);
+    VERIFICAR(mochilaDesfazer(&m) == MOCHILA_OK);
+    VERIFICAR(mochilaLocalizar(&m, "unico", &indice) == MOCHILA_OK);
+    VERIFICAR(m.itens[indice].quantidade == 1);
+    
+    // Nome longo demais é recusado (truncado, nunca seria restaurado)
+    char longo[MAX_NOME + 21];
+    memset(longo, 'x', sizeof(longo) - 1);
+    longo[sizeof(longo) - 1] = '\0';
+    VERIFICAR(mochilaSalvarSnapshot(&m, longo) == MOCHILA_ARGUMENTO_INVALIDO);
+    VERIFICAR(mochilaRestaurarSnapshot(&m, longo) == MOCHILA_ARGUMENTO_INVALIDO);
+    longo[MAX_NOME - 1] = '\0';    // Maior nome aceito: MAX_NOME - 1 caracteres
+    VERIFICAR(mochilaSalvarSnapshot(&m, longo) == MOCHILA_OK);
+    VERIFICAR(mochilaSalvarSnapshot(&m, longo) == MOCHILA_OK);
+    VERIFICAR(mochilaRestaurarSnapshot(&m, longo) == MOCHILA_OK);
+    
+    mochilaLiberar(&m);
+}
+
+/**
+ * Funcao main: executa todos os grupos e devolve 1 se algum falhou
+ */
+int main() {
+    srand(2024);    // Semente fixa: falhas reproduzíveis
+    
+    testarOperacoesBasicas();
+    testarBuscas();
+    testarHistorico();
+    
+    if(falhas > 0) {
+        printf("%d verificacao(oes) falharam.\n", falhas);
+        return 1;
+    }
+    printf("Todos os testes passaram.\n");
+    return 0;
+}